@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 namespace MySTL
@@ -11,4 +12,62 @@ namespace MySTL
         a = std::move(b);
         b = std::move(tmp);
     }
+
+    namespace detail
+    {
+        // 只有能解引用和前置自增的类型才替换成功，用于约束接受迭代器对的模板，
+        // 避免 insert(1, 2) 这类两个同类型参数的调用被迭代器版本抢走
+        template<typename It>
+        using require_iterator = decltype(*std::declval<It &>(), ++std::declval<It &>(), void());
+
+        // 支持相减的迭代器（指针、vector 迭代器）直接 O(1) 求距离
+        template<typename It>
+        auto distance(It first, It last, int) -> decltype(last - first)
+        {
+            return last - first;
+        }
+
+        // 否则只能逐个数过去，要求至少是前向迭代器（可多次遍历）
+        template<typename It>
+        std::ptrdiff_t distance(It first, It last, long)
+        {
+            std::ptrdiff_t n = 0;
+            for (; first != last; ++first) {
+                ++n;
+            }
+            return n;
+        }
+    } // namespace detail
+
+    // MySTL 的迭代器没有提供 iterator_traits，这里用表达式探测代替 iterator_category 分派
+    template<typename It>
+    std::ptrdiff_t distance(It first, It last)
+    {
+        return detail::distance(first, last, 0);
+    }
+
+    // 无分支二分查找：返回 [base, base + n) 中第一个不小于 key 的位置
+    // 循环体只有一次比较和一次条件选择（编译为 cmov），不会因分支预测失败而清空流水线；
+    // 同时预取下一轮可能访问的两个位置，缓存未命中时能把访存延迟重叠起来
+    template<typename T, typename Key, typename Compare>
+    const T* branchless_lower_bound(
+            const T* base,
+            size_t n,
+            const Key& key,
+            Compare comp)
+    {
+        if (n == 0) {
+            return base;
+        }
+        while (n > 1) {
+            size_t half = n / 2;
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+#endif
+            base = comp(base[half - 1], key) ? base + half : base;
+            n -= half;
+        }
+        return base + (comp(*base, key) ? 1 : 0);
+    }
 } // namespace MySTL
\ No newline at end of file
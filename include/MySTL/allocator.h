@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef> // size_t、ptrdiff_t、max_align_t
+#include <cstdlib> // posix_memalign、free
+#include <new>
+#include <type_traits> // true_type
+#include <utility>     // declval
+
+#ifdef _WIN32
+#include <malloc.h> // _aligned_malloc
+#endif
+
+namespace MySTL
+{
+    // 常见 x86/ARM 处理器的缓存行大小
+    constexpr size_t cache_line_size = 64;
+
+    namespace detail
+    {
+        // C++14 没有带对齐参数的 operator new，这里直接使用平台接口
+        // alignment 必须是 2 的幂
+        inline void* aligned_allocate(size_t bytes, size_t alignment)
+        {
+            if (alignment < sizeof(void*)) {
+                alignment = sizeof(void*); // posix_memalign 的最低要求
+            }
+            if (bytes == 0) {
+                bytes = alignment; // 保证返回一个可释放的非空指针
+            }
+#ifdef _WIN32
+            void* p = ::_aligned_malloc(bytes, alignment);
+            if (p == nullptr) {
+                throw std::bad_alloc();
+            }
+#else
+            void* p = nullptr;
+            if (::posix_memalign(&p, alignment, bytes) != 0) {
+                throw std::bad_alloc();
+            }
+#endif
+            return p;
+        }
+
+        inline void aligned_deallocate(void* p) noexcept
+        {
+#ifdef _WIN32
+            ::_aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+    } // namespace detail
+
+    // 默认分配器：直接转发到全局的 operator new / operator delete
+    // 满足 std::allocator_traits 的最小要求，容器统一通过 allocator_traits 使用它，
+    // 因此任何符合标准的分配器（内存池、arena 等）都可以替换进来
+    template<typename T>
+    class allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+
+        // 无状态分配器，任意两个实例都可以互相释放对方分配的内存
+        using is_always_equal = std::true_type;
+
+        allocator() noexcept = default;
+
+        // 用于 rebind：list 等容器需要从 allocator<T> 得到 allocator<Node>
+        template<typename U>
+        allocator(const allocator<U>&) noexcept
+        {
+        }
+
+        // 超额对齐的 T（如 alignas(64) 的计数器）需要走对齐分配，
+        // 否则 operator new 只保证 alignof(max_align_t)
+        T* allocate(size_t n)
+        {
+            return allocate(n, over_aligned());
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            deallocate(p, over_aligned());
+        }
+
+    private:
+        using over_aligned = std::integral_constant<
+                bool, (alignof(T) > alignof(std::max_align_t))>;
+
+        T* allocate(size_t n, std::false_type)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        T* allocate(size_t n, std::true_type)
+        {
+            return static_cast<T*>(
+                    detail::aligned_allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, std::false_type) noexcept
+        {
+            ::operator delete(p);
+        }
+
+        void deallocate(T* p, std::true_type) noexcept
+        {
+            detail::aligned_deallocate(p);
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator==(const allocator<T>&, const allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const allocator<T>&, const allocator<U>&) noexcept
+    {
+        return false;
+    }
+
+    // 保证返回的内存首地址按 Alignment 字节对齐（且不低于 alignof(T)）
+    // 例如 MySTL::vector<float, aligned_allocator<float, 32>> 的 data() 可直接用于 AVX2 对齐加载，
+    // 64 对应 AVX-512 以及缓存行
+    template<typename T, size_t Alignment = cache_line_size>
+    class aligned_allocator
+    {
+        static_assert(
+                Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using is_always_equal = std::true_type;
+
+        static constexpr size_t alignment =
+                Alignment > alignof(T) ? Alignment : alignof(T);
+
+        // 模板参数中有非类型参数，allocator_traits 无法自动 rebind，需要手动提供
+        template<typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template<typename U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(
+                    detail::aligned_allocate(n * sizeof(T), alignment));
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            detail::aligned_deallocate(p);
+        }
+    };
+
+    template<typename T, typename U, size_t A>
+    bool operator==(
+            const aligned_allocator<T, A>&,
+            const aligned_allocator<U, A>&) noexcept
+    {
+        return true;
+    }
+
+    template<typename T, typename U, size_t A>
+    bool operator!=(
+            const aligned_allocator<T, A>&,
+            const aligned_allocator<U, A>&) noexcept
+    {
+        return false;
+    }
+
+    // 检测分配器是否提供扩展成员 reallocate(p, old_n, new_n)
+    // 提供时，容器对可平凡重定位的元素可以原地调整缓冲区大小（如 mmap_allocator 的 mremap）
+    template<typename Alloc, typename = void>
+    struct has_reallocate : std::false_type
+    {
+    };
+
+    template<typename Alloc>
+    struct has_reallocate<
+            Alloc,
+            decltype((void)std::declval<Alloc&>().reallocate(
+                    std::declval<typename Alloc::value_type*>(), size_t(),
+                    size_t()))> : std::true_type
+    {
+    };
+} // namespace MySTL
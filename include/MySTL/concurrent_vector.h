@@ -0,0 +1,308 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef> // 引入size_t
+#include <cstdlib> // 引入abort
+#include <memory>  // 引入allocator_traits
+#include <type_traits>
+#include <utility> // 引入forward、move
+#include "allocator.h"
+
+namespace MySTL {
+
+    namespace detail {
+        // 最高位 1 的下标，v 必须大于 0
+        inline size_t floor_log2(size_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+            return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(v);
+#else
+            size_t r = 0;
+            while (v >>= 1) {
+                r++;
+            }
+            return r;
+#endif
+        }
+    }
+
+    // 多生产者无锁并发追加的只增长 vector
+    //
+    // 存储由一组按几何级数增长的块组成：第 k 块容纳 32 << k 个元素，块分配后永不移动，
+    // 因此已发布元素的地址在容器析构前一直有效，读者无需加锁。
+    // 每块配有同样长度的就绪标志数组，标记对应槽位是否已构造完成。
+    //
+    // push_back 的流程：
+    //   1. 在调用线程内先把元素构造到临时对象（可能抛异常，此时尚未占用任何下标）
+    //   2. reserved_.fetch_add(1) 领取下标，必要时 CAS 安装新块
+    //   3. 把临时对象移动到槽位中（要求 T 的移动构造不抛异常，保证领取的下标一定会被填上）
+    //   4. 置位该槽的就绪标志，再顺手推进 size_，然后立即返回，不等待任何其他生产者
+    // size() 把 size_ 沿着连续就绪的槽向前推进（CAS，谁推都行），
+    // 因此读者看到的 size() 永远是"已经构造完成"的连续前缀，[0, size()) 内可以安全读取。
+    //
+    // 生产者之间互不等待；某个生产者在第 2、3 步之间被挂起时，只有 size() 暂时停在它的下标处，
+    // 其后已完成的元素要等它完成后才对读者可见。
+    // clear、析构以及拷贝/移动不是线程安全的，需要在所有生产者结束后调用。
+    template<typename T, typename Alloc = MySTL::allocator<T>>
+    class concurrent_vector {
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                "concurrent_vector requires a noexcept move constructor");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using flag_type = std::atomic<bool>;
+        using flag_allocator = typename alloc_traits::template rebind_alloc<flag_type>;
+        using flag_traits = std::allocator_traits<flag_allocator>;
+
+        static constexpr size_t first_bucket_bits = 5;
+        static constexpr size_t first_bucket_size = size_t(1) << first_bucket_bits;
+        static constexpr size_t bucket_count = sizeof(size_t) * 8 - first_bucket_bits;
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+        using allocator_type = Alloc;
+
+        // ================== 迭代器实现 ==================
+        // 迭代器只记录下标，begin()/end() 取的是调用那一刻已发布的前缀，之后追加的元素不会被遍历到
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+
+            iterator(concurrent_vector* vec, size_t index) : vec_(vec), index_(index) {}
+
+            reference operator*() const { return (*vec_)[index_]; }
+            pointer operator->() const { return &(*vec_)[index_]; }
+
+            iterator& operator++() { index_++; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+        private:
+            concurrent_vector* vec_;
+            size_t index_;
+        };
+
+        class const_iterator {
+        public:
+            const_iterator(const concurrent_vector* vec, size_t index) : vec_(vec), index_(index) {}
+
+            const_iterator(const iterator& other) : vec_(other.vec_), index_(other.index_) {}
+
+            const_reference operator*() const { return (*vec_)[index_]; }
+            const_pointer operator->() const { return &(*vec_)[index_]; }
+
+            const_iterator& operator++() { index_++; return *this; }
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+        private:
+            const concurrent_vector* vec_;
+            size_t index_;
+        };
+
+        concurrent_vector() : reserved_(0), size_(0), alloc_() {
+            for (size_t k = 0; k < bucket_count; k++) {
+                buckets_[k].store(nullptr, std::memory_order_relaxed);
+                ready_[k].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        explicit concurrent_vector(const Alloc& alloc) : concurrent_vector() {
+            alloc_ = alloc;
+        }
+
+        ~concurrent_vector() {
+            clear();
+            for (size_t k = 0; k < bucket_count; k++) {
+                pointer bucket = buckets_[k].load(std::memory_order_relaxed);
+                if (bucket != nullptr) {
+                    alloc_traits::deallocate(alloc_, bucket, bucket_size(k));
+                }
+                flag_type* flags = ready_[k].load(std::memory_order_relaxed);
+                if (flags != nullptr) {
+                    flag_allocator flag_alloc(alloc_);
+                    for (size_t i = 0; i < bucket_size(k); i++) {
+                        flag_traits::destroy(flag_alloc, flags + i);
+                    }
+                    flag_traits::deallocate(flag_alloc, flags, bucket_size(k));
+                }
+            }
+        }
+
+        // 原子成员不可拷贝，且拷贝一个仍在被写入的容器没有意义
+        concurrent_vector(const concurrent_vector&) = delete;
+        concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        // 已发布（可安全读取）的元素个数，即从 0 开始连续就绪的槽数
+        size_t size() const noexcept { return advance_size(); }
+        bool empty() const noexcept { return size() == 0; }
+
+        // 以下追加操作可以被任意多个线程同时调用，返回新元素的下标
+        size_t push_back(const_reference value) {
+            return append(value_type(value));
+        }
+
+        size_t push_back(value_type&& value) {
+            return append(std::move(value));
+        }
+
+        template<typename... Args>
+        size_t emplace_back(Args&&... args) {
+            return append(value_type(std::forward<Args>(args)...));
+        }
+
+        // 预先分配能容纳 n 个元素的块，避免生产者在热路径上分配。可与 push_back 并发调用
+        void reserve(size_t n) {
+            if (n == 0) {
+                return;
+            }
+            size_t last = bucket_of(n - 1);
+            for (size_t k = 0; k <= last; k++) {
+                ensure_flags(k);
+                ensure_bucket(k);
+            }
+        }
+
+        // 只允许访问 [0, size()) 内的元素
+        reference operator[](size_t index) {
+            size_t k = bucket_of(index);
+            return buckets_[k].load(std::memory_order_acquire)[offset_in(index, k)];
+        }
+
+        const_reference operator[](size_t index) const {
+            size_t k = bucket_of(index);
+            return buckets_[k].load(std::memory_order_acquire)[offset_in(index, k)];
+        }
+
+        // 非线程安全：析构所有元素，但保留已分配的块供之后复用
+        void clear() noexcept {
+            size_t n = reserved_.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; i++) {
+                flag_type& flag = ready_flag(i);
+                alloc_traits::destroy(alloc_, &(*this)[i]);
+                flag.store(false, std::memory_order_relaxed);
+            }
+            reserved_.store(0, std::memory_order_relaxed);
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<pointer> buckets_[bucket_count];
+        std::atomic<flag_type*> ready_[bucket_count]; // 与 buckets_ 一一对应的就绪标志
+        std::atomic<size_t> reserved_; // 已领取的下标数
+        // 已发布的下标数，size_ <= reserved_；只会单调增长，const 的 size() 也可以推进它
+        mutable std::atomic<size_t> size_;
+        Alloc alloc_;
+
+        static size_t bucket_size(size_t k) noexcept {
+            return first_bucket_size << k;
+        }
+
+        // 下标 i 所在的块：把 i + 32 看成二进制数，最高位决定块号
+        static size_t bucket_of(size_t index) noexcept {
+            return detail::floor_log2(index + first_bucket_size) - first_bucket_bits;
+        }
+
+        static size_t offset_in(size_t index, size_t k) noexcept {
+            return index + first_bucket_size - bucket_size(k);
+        }
+
+        // 保证第 k 块已分配。多个线程可能同时分配，只有 CAS 成功的那个被采用
+        pointer ensure_bucket(size_t k) {
+            pointer bucket = buckets_[k].load(std::memory_order_acquire);
+            if (bucket != nullptr) {
+                return bucket;
+            }
+            pointer fresh = alloc_traits::allocate(alloc_, bucket_size(k));
+            if (buckets_[k].compare_exchange_strong(bucket, fresh, std::memory_order_acq_rel)) {
+                return fresh;
+            }
+            alloc_traits::deallocate(alloc_, fresh, bucket_size(k));
+            return bucket; // CAS 失败时 bucket 已被更新为别人安装的块
+        }
+
+        // 与 ensure_bucket 相同，安装第 k 块的就绪标志数组（全部为 false）
+        flag_type* ensure_flags(size_t k) {
+            flag_type* flags = ready_[k].load(std::memory_order_acquire);
+            if (flags != nullptr) {
+                return flags;
+            }
+            flag_allocator flag_alloc(alloc_);
+            flag_type* fresh = flag_traits::allocate(flag_alloc, bucket_size(k));
+            for (size_t i = 0; i < bucket_size(k); i++) {
+                flag_traits::construct(flag_alloc, fresh + i, false);
+            }
+            if (ready_[k].compare_exchange_strong(flags, fresh, std::memory_order_acq_rel)) {
+                return fresh;
+            }
+            flag_traits::deallocate(flag_alloc, fresh, bucket_size(k));
+            return flags;
+        }
+
+        // 调用前该下标所在块的标志数组必须已安装
+        flag_type& ready_flag(size_t index) const noexcept {
+            size_t k = bucket_of(index);
+            return ready_[k].load(std::memory_order_acquire)[offset_in(index, k)];
+        }
+
+        // 沿连续就绪的槽推进 size_，返回推进后的值
+        // 多个线程可能同时推进，CAS 失败说明别人已推过，从新值继续即可
+        size_t advance_size() const noexcept {
+            size_t n = size_.load(std::memory_order_acquire);
+            while (n < reserved_.load(std::memory_order_acquire)) {
+                size_t k = bucket_of(n);
+                flag_type* flags = ready_[k].load(std::memory_order_acquire);
+                if (flags == nullptr || !flags[offset_in(n, k)].load(std::memory_order_acquire)) {
+                    break; // 该槽的生产者还没完成
+                }
+                if (size_.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    n++;
+                }
+            }
+            return n;
+        }
+
+        size_t append(value_type&& value) {
+            size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+            size_t k = bucket_of(index);
+            flag_type* flags = ensure_or_abort(k);
+            pointer bucket = buckets_[k].load(std::memory_order_acquire);
+            alloc_traits::construct(alloc_, &bucket[offset_in(index, k)], std::move(value));
+
+            // 只发布自己的槽，不等待前面的生产者；能推进多少由 advance_size 决定
+            flags[offset_in(index, k)].store(true, std::memory_order_release);
+            advance_size();
+            return index;
+        }
+
+        // 下标一旦领取就必须被填上，否则 size() 会永远停在这个下标之前；
+        // 此时分配失败已无法回滚，只能终止程序
+        flag_type* ensure_or_abort(size_t k) noexcept {
+            try {
+                flag_type* flags = ensure_flags(k);
+                ensure_bucket(k);
+                return flags;
+            }
+            catch (...) {
+                std::abort();
+            }
+        }
+    };
+}
@@ -0,0 +1,367 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <memory>  // 引入allocator_traits
+#include <stdexcept>
+#include <utility> // 引入forward、move
+#include "algorithm.h"
+#include "allocator.h"
+#include "vector.h"
+
+namespace MySTL {
+
+    namespace detail {
+        // 每块约 4KB，向下取整到 2 的幂（下标换算只需移位和掩码），至少 16 个元素
+        constexpr size_t deque_block_size(size_t elem_size) {
+            size_t n = elem_size < 4096 ? 4096 / elem_size : 1;
+            size_t p = 16;
+            while (p * 2 <= n) {
+                p *= 2;
+            }
+            return p;
+        }
+    }
+
+    // 分段存储的双端队列
+    // 元素存放在固定大小的块中，块一经分配就不再移动：
+    //   1. push_front / push_back 均摊 O(1)，扩容只重新分配"块指针表"，从不拷贝元素
+    //   2. 在两端插入、删除不会使其他元素的指针和引用失效（迭代器仍会失效）
+    //   3. 支持 O(1) 随机访问
+    // 块指针表直接复用 MySTL::vector，两端都预留空位以支持 push_front
+    template<typename T, typename Alloc = MySTL::allocator<T>, size_t BlockSize = detail::deque_block_size(sizeof(T))>
+    class deque {
+        static_assert((BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using map_type = MySTL::vector<T*, typename alloc_traits::template rebind_alloc<T*>>;
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+        using allocator_type = Alloc;
+
+        static constexpr size_t block_size = BlockSize;
+
+        // ================== 迭代器实现 ==================
+        // 迭代器记录块指针表和全局位置，++/-- 只改位置，解引用时再换算成 (块, 块内偏移)
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+
+            iterator(pointer* map, size_t pos) : map_(map), pos_(pos) {}
+
+            reference operator*() const { return map_[pos_ / BlockSize][pos_ % BlockSize]; }
+            pointer operator->() const { return &**this; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            iterator& operator++() { pos_++; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            iterator& operator--() { pos_--; return *this; }
+            iterator operator--(int) { iterator tmp = *this; --(*this); return tmp; }
+
+            iterator operator+(difference_type n) const { return iterator(map_, pos_ + n); }
+            iterator operator-(difference_type n) const { return iterator(map_, pos_ - n); }
+            difference_type operator-(const iterator& other) const {
+                return static_cast<difference_type>(pos_) - static_cast<difference_type>(other.pos_);
+            }
+
+            bool operator<(const iterator& other) const { return pos_ < other.pos_; }
+            bool operator>(const iterator& other) const { return pos_ > other.pos_; }
+            bool operator<=(const iterator& other) const { return pos_ <= other.pos_; }
+            bool operator>=(const iterator& other) const { return pos_ >= other.pos_; }
+
+            bool operator==(const iterator& other) const { return pos_ == other.pos_; }
+            bool operator!=(const iterator& other) const { return pos_ != other.pos_; }
+
+        private:
+            pointer* map_;
+            size_t pos_;
+        };
+
+        class const_iterator {
+        public:
+            const_iterator(pointer* map, size_t pos) : map_(map), pos_(pos) {}
+
+            const_iterator(const iterator& other) : map_(other.map_), pos_(other.pos_) {}
+
+            const_reference operator*() const { return map_[pos_ / BlockSize][pos_ % BlockSize]; }
+            const_pointer operator->() const { return &**this; }
+            const_reference operator[](difference_type n) const { return *(*this + n); }
+
+            const_iterator& operator++() { pos_++; return *this; }
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            const_iterator& operator--() { pos_--; return *this; }
+            const_iterator operator--(int) { const_iterator tmp = *this; --(*this); return tmp; }
+
+            const_iterator operator+(difference_type n) const { return const_iterator(map_, pos_ + n); }
+            const_iterator operator-(difference_type n) const { return const_iterator(map_, pos_ - n); }
+            difference_type operator-(const const_iterator& other) const {
+                return static_cast<difference_type>(pos_) - static_cast<difference_type>(other.pos_);
+            }
+
+            bool operator<(const const_iterator& other) const { return pos_ < other.pos_; }
+            bool operator>(const const_iterator& other) const { return pos_ > other.pos_; }
+            bool operator<=(const const_iterator& other) const { return pos_ <= other.pos_; }
+            bool operator>=(const const_iterator& other) const { return pos_ >= other.pos_; }
+
+            bool operator==(const const_iterator& other) const { return pos_ == other.pos_; }
+            bool operator!=(const const_iterator& other) const { return pos_ != other.pos_; }
+
+        private:
+            pointer* map_;
+            size_t pos_;
+        };
+
+        deque() noexcept : map_(), first_(0), size_(0), alloc_() {}
+
+        explicit deque(const Alloc& alloc) : map_(), first_(0), size_(0), alloc_(alloc) {}
+
+        deque(size_t n, const value_type& value = value_type(), const Alloc& alloc = Alloc())
+            : map_(), first_(0), size_(0), alloc_(alloc)
+        {
+            // 构造函数抛异常时析构函数不会执行，需要自己释放已构造的元素和块
+            try {
+                for (size_t i = 0; i < n; i++) {
+                    push_back(value);
+                }
+            }
+            catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        ~deque() {
+            clear();
+        }
+
+        // ================== 五法则实现 ==================
+
+        deque(const deque& other)
+            : map_(), first_(0), size_(0),
+              alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
+            try {
+                for (size_t i = 0; i < other.size_; i++) {
+                    push_back(other[i]);
+                }
+            }
+            catch (...) {
+                clear();
+                throw;
+            }
+        }
+
+        deque& operator=(const deque& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            for (size_t i = 0; i < other.size_; i++) {
+                push_back(other[i]);
+            }
+            return *this;
+        }
+
+        // 只交换块指针表，元素地址保持不变
+        deque(deque&& other) noexcept
+            : map_(std::move(other.map_)), first_(other.first_), size_(other.size_), alloc_(std::move(other.alloc_))
+        {
+            other.first_ = 0;
+            other.size_ = 0;
+        }
+
+        deque& operator=(deque&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            map_ = std::move(other.map_);
+            first_ = other.first_;
+            size_ = other.size_;
+            alloc_ = std::move(other.alloc_);
+            other.first_ = 0;
+            other.size_ = 0;
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(map_.data(), first_); }
+        iterator end() noexcept { return iterator(map_.data(), first_ + size_); }
+        const_iterator begin() const noexcept { return const_iterator(const_cast<pointer*>(map_.data()), first_); }
+        const_iterator end() const noexcept { return const_iterator(const_cast<pointer*>(map_.data()), first_ + size_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        allocator_type get_allocator() const noexcept { return alloc_; }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value) {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            if ((first_ + size_) / BlockSize >= map_.size()) {
+                grow_map();
+            }
+            size_t pos = first_ + size_;
+            pointer slot = block_for(pos) + pos % BlockSize;
+            try {
+                alloc_traits::construct(alloc_, slot, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                release_if_empty(pos / BlockSize);
+                throw;
+            }
+            size_++;
+        }
+
+        void push_front(const_reference value) {
+            emplace_front(value);
+        }
+
+        void push_front(value_type&& value) {
+            emplace_front(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace_front(Args&&... args) {
+            if (first_ == 0) {
+                grow_map();
+            }
+            size_t pos = first_ - 1;
+            pointer slot = block_for(pos) + pos % BlockSize;
+            try {
+                alloc_traits::construct(alloc_, slot, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                release_if_empty(pos / BlockSize);
+                throw;
+            }
+            first_--;
+            size_++;
+        }
+
+        void pop_back() {
+            if (size_ == 0) {
+                return;
+            }
+            size_t pos = first_ + size_ - 1;
+            alloc_traits::destroy(alloc_, &map_[pos / BlockSize][pos % BlockSize]);
+            size_--;
+            release_if_empty(pos / BlockSize);
+        }
+
+        void pop_front() {
+            if (size_ == 0) {
+                return;
+            }
+            size_t pos = first_;
+            alloc_traits::destroy(alloc_, &map_[pos / BlockSize][pos % BlockSize]);
+            first_++;
+            size_--;
+            release_if_empty(pos / BlockSize);
+        }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        reference operator[](size_t index) {
+            size_t pos = first_ + index;
+            return map_[pos / BlockSize][pos % BlockSize];
+        }
+
+        const_reference operator[](size_t index) const {
+            size_t pos = first_ + index;
+            return map_[pos / BlockSize][pos % BlockSize];
+        }
+
+        reference at(size_t index) {
+            if (index >= size_) {
+                throw std::out_of_range("deque::at: index out of range");
+            }
+            return (*this)[index];
+        }
+
+        const_reference at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("deque::at: index out of range");
+            }
+            return (*this)[index];
+        }
+
+        void clear() noexcept {
+            while (size_ > 0) {
+                pop_back();
+            }
+            first_ = map_.size() / 2 * BlockSize;
+        }
+
+        void swap(deque& other) noexcept {
+            map_.swap(other.map_);
+            MySTL::swap(first_, other.first_);
+            MySTL::swap(size_, other.size_);
+            MySTL::swap(alloc_, other.alloc_);
+        }
+
+    private:
+        // 不变式：map_ 中某个槽非空，当且仅当对应块里至少有一个元素（或正在构造第一个元素）
+        map_type map_;
+        size_t first_; // 首元素的全局位置，即 块号 * BlockSize + 块内偏移
+        size_t size_;
+        Alloc alloc_;
+
+        // 返回位置 pos 所在的块，必要时分配
+        pointer block_for(size_t pos) {
+            pointer& block = map_[pos / BlockSize];
+            if (block == nullptr) {
+                block = alloc_traits::allocate(alloc_, BlockSize);
+            }
+            return block;
+        }
+
+        // 块中已经没有元素时立即归还，队列式使用（尾进头出）时内存不会持续增长
+        void release_if_empty(size_t block_index) noexcept {
+            size_t first_block = first_ / BlockSize;
+            size_t last_block = (first_ + size_ + BlockSize - 1) / BlockSize; // 开区间
+            bool in_use = size_ > 0 && block_index >= first_block && block_index < last_block;
+            if (!in_use && map_[block_index] != nullptr) {
+                alloc_traits::deallocate(alloc_, map_[block_index], BlockSize);
+                map_[block_index] = nullptr;
+            }
+        }
+
+        // 重新分配块指针表，已用的块居中放置，两端各留出空位
+        // 只搬动指针，元素本身不动
+        void grow_map() {
+            size_t first_block = first_ / BlockSize;
+            size_t used = size_ == 0 ? 0 : (first_ + size_ - 1) / BlockSize - first_block + 1;
+            size_t new_size = used * 2 + 2 < 8 ? 8 : used * 2 + 2;
+            size_t new_first_block = (new_size - used) / 2;
+
+            map_type new_map(new_size, nullptr);
+            for (size_t i = 0; i < used; i++) {
+                new_map[new_first_block + i] = map_[first_block + i];
+            }
+            first_ = new_first_block * BlockSize + first_ % BlockSize;
+            map_.swap(new_map);
+        }
+    };
+}
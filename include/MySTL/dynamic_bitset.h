@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <cstdint> // 引入uint64_t
+#include <stdexcept>
+#include "vector.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace MySTL {
+
+    namespace detail {
+        inline size_t popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(__builtin_popcountll(w));
+#else
+            w = w - ((w >> 1) & 0x5555555555555555ULL);
+            w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+            w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return static_cast<size_t>((w * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // 最低位 1 的下标，w 必须非 0
+        inline size_t ctz64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(__builtin_ctzll(w));
+#else
+            size_t n = 0;
+            while ((w & 1) == 0) {
+                w >>= 1;
+                n++;
+            }
+            return n;
+#endif
+        }
+
+        // dynamic_bitset 不是模板，C++14 中类内的 static constexpr 成员被 ODR 使用（如绑定到 std::min 的引用参数）时
+        // 需要类外定义，而非模板类的类外定义放在头文件里又会违反 ODR。
+        // 放进模板基类，类外定义就可以写在头文件中
+        template<typename = void>
+        struct dynamic_bitset_constants {
+            static constexpr size_t bits_per_word = 64;
+            static constexpr size_t npos = static_cast<size_t>(-1);
+        };
+
+        template<typename V>
+        constexpr size_t dynamic_bitset_constants<V>::bits_per_word;
+
+        template<typename V>
+        constexpr size_t dynamic_bitset_constants<V>::npos;
+    }
+
+    // 按位压缩存储的动态布尔数组，每个 64 位字存放 64 个标志
+    // 相比一字节一个 bool 内存减少到 1/8，批量逻辑运算一次处理 64 位（编译器还可继续向量化）
+    // 不变式：最后一个字中超出 size() 的高位始终为 0，count/any/all 等可以直接按字计算
+    // bits_per_word 与 npos 继承自 detail::dynamic_bitset_constants
+    class dynamic_bitset : public detail::dynamic_bitset_constants<> {
+    public:
+        using word_type = uint64_t;
+
+        dynamic_bitset() noexcept : words_(), size_(0) {}
+
+        explicit dynamic_bitset(size_t n, bool value = false)
+            : words_(word_count(n), value ? ~word_type(0) : word_type(0)), size_(n)
+        {
+            clear_unused_bits();
+        }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t num_words() const noexcept { return words_.size(); }
+
+        // 底层字数组，便于与其他位图格式直接交换数据
+        word_type* data() noexcept { return words_.data(); }
+        const word_type* data() const noexcept { return words_.data(); }
+
+        void resize(size_t n, bool value = false) {
+            size_t old_size = size_;
+            words_.resize(word_count(n));
+            size_ = n;
+            if (value && n > old_size) {
+                // 新增的位置 1：先补齐旧的最后一个字，再整字填充
+                for (size_t i = old_size; i < n && i % bits_per_word != 0; i++) {
+                    set(i);
+                }
+                for (size_t w = word_count(old_size); w < words_.size(); w++) {
+                    words_[w] = ~word_type(0);
+                }
+            }
+            clear_unused_bits();
+        }
+
+        void push_back(bool value) {
+            resize(size_ + 1);
+            if (value) {
+                set(size_ - 1);
+            }
+        }
+
+        void clear() noexcept {
+            words_.clear();
+            size_ = 0;
+        }
+
+        // ================== 单个位操作 ==================
+        bool test(size_t pos) const {
+            return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+        }
+
+        bool operator[](size_t pos) const { return test(pos); }
+
+        dynamic_bitset& set(size_t pos, bool value = true) {
+            word_type mask = word_type(1) << (pos % bits_per_word);
+            if (value) {
+                words_[pos / bits_per_word] |= mask;
+            }
+            else {
+                words_[pos / bits_per_word] &= ~mask;
+            }
+            return *this;
+        }
+
+        dynamic_bitset& reset(size_t pos) {
+            return set(pos, false);
+        }
+
+        dynamic_bitset& flip(size_t pos) {
+            words_[pos / bits_per_word] ^= word_type(1) << (pos % bits_per_word);
+            return *this;
+        }
+
+        // ================== 整体操作 ==================
+        dynamic_bitset& set() noexcept {
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] = ~word_type(0);
+            }
+            clear_unused_bits();
+            return *this;
+        }
+
+        dynamic_bitset& reset() noexcept {
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] = 0;
+            }
+            return *this;
+        }
+
+        dynamic_bitset& flip() noexcept {
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] = ~words_[i];
+            }
+            clear_unused_bits();
+            return *this;
+        }
+
+        // 置 1 的位数
+        size_t count() const noexcept {
+            return count_words(words_.data(), words_.size());
+        }
+
+        bool any() const noexcept {
+            const word_type* w = words_.data();
+            size_t n = words_.size();
+            size_t i = 0;
+            // 每次合并 4 个字再判断，减少分支
+            for (; i + 4 <= n; i += 4) {
+                if ((w[i] | w[i + 1] | w[i + 2] | w[i + 3]) != 0) {
+                    return true;
+                }
+            }
+            for (; i < n; i++) {
+                if (w[i] != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool none() const noexcept { return !any(); }
+
+        bool all() const noexcept {
+            if (size_ == 0) {
+                return true;
+            }
+            size_t full = size_ / bits_per_word;
+            for (size_t i = 0; i < full; i++) {
+                if (words_[i] != ~word_type(0)) {
+                    return false;
+                }
+            }
+            size_t rest = size_ % bits_per_word;
+            return rest == 0 || words_[full] == (word_type(1) << rest) - 1;
+        }
+
+        // ================== 查找 ==================
+        // 第一个置 1 的位，不存在时返回 npos
+        size_t find_first() const noexcept {
+            return find_from_word(0);
+        }
+
+        // pos 之后（不含 pos）第一个置 1 的位，不存在时返回 npos
+        size_t find_next(size_t pos) const noexcept {
+            size_t next = pos + 1;
+            if (next >= size_) {
+                return npos;
+            }
+            size_t w = next / bits_per_word;
+            // 先屏蔽当前字中 next 之前的位
+            word_type bits = words_[w] & (~word_type(0) << (next % bits_per_word));
+            if (bits != 0) {
+                return w * bits_per_word + detail::ctz64(bits);
+            }
+            return find_from_word(w + 1);
+        }
+
+        // 遍历所有置 1 的位，逐字用 w &= w - 1 剥离最低位，跳过全 0 的字
+        template<typename F>
+        void for_each_set(F f) const {
+            for (size_t i = 0; i < words_.size(); i++) {
+                word_type w = words_[i];
+                while (w != 0) {
+                    f(i * bits_per_word + detail::ctz64(w));
+                    w &= w - 1;
+                }
+            }
+        }
+
+        // ================== 批量逻辑运算 ==================
+        // 要求两个位图长度相同
+        dynamic_bitset& operator&=(const dynamic_bitset& other) {
+            check_same_size(other);
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] &= other.words_[i];
+            }
+            return *this;
+        }
+
+        dynamic_bitset& operator|=(const dynamic_bitset& other) {
+            check_same_size(other);
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] |= other.words_[i];
+            }
+            return *this;
+        }
+
+        dynamic_bitset& operator^=(const dynamic_bitset& other) {
+            check_same_size(other);
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] ^= other.words_[i];
+            }
+            return *this;
+        }
+
+        // this &= ~other，即从当前集合中去掉 other 中的元素
+        dynamic_bitset& and_not(const dynamic_bitset& other) {
+            check_same_size(other);
+            for (size_t i = 0; i < words_.size(); i++) {
+                words_[i] &= ~other.words_[i];
+            }
+            return *this;
+        }
+
+        dynamic_bitset operator~() const {
+            dynamic_bitset result(*this);
+            result.flip();
+            return result;
+        }
+
+        friend dynamic_bitset operator&(dynamic_bitset a, const dynamic_bitset& b) { return a &= b; }
+        friend dynamic_bitset operator|(dynamic_bitset a, const dynamic_bitset& b) { return a |= b; }
+        friend dynamic_bitset operator^(dynamic_bitset a, const dynamic_bitset& b) { return a ^= b; }
+
+        bool operator==(const dynamic_bitset& other) const {
+            if (size_ != other.size_) {
+                return false;
+            }
+            for (size_t i = 0; i < words_.size(); i++) {
+                if (words_[i] != other.words_[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const dynamic_bitset& other) const { return !(*this == other); }
+
+        void swap(dynamic_bitset& other) noexcept {
+            words_.swap(other.words_);
+            MySTL::swap(size_, other.size_);
+        }
+
+    private:
+        MySTL::vector<word_type> words_;
+        size_t size_;
+
+        static size_t word_count(size_t bits) noexcept {
+            return (bits + bits_per_word - 1) / bits_per_word;
+        }
+
+        void clear_unused_bits() noexcept {
+            size_t rest = size_ % bits_per_word;
+            if (rest != 0) {
+                words_[words_.size() - 1] &= (word_type(1) << rest) - 1;
+            }
+        }
+
+        void check_same_size(const dynamic_bitset& other) const {
+            if (size_ != other.size_) {
+                throw std::invalid_argument("dynamic_bitset: operands have different sizes");
+            }
+        }
+
+        size_t find_from_word(size_t w) const noexcept {
+            for (; w < words_.size(); w++) {
+                if (words_[w] != 0) {
+                    return w * bits_per_word + detail::ctz64(words_[w]);
+                }
+            }
+            return npos;
+        }
+
+        static size_t count_words(const word_type* w, size_t n) noexcept {
+            size_t i = 0;
+            size_t total = 0;
+#if defined(__AVX2__)
+            // 查表法（Mula）：每个字节拆成高低两个 4 位，用 pshufb 查 16 项的位数表，
+            // 再用 sad 把字节和累加到 4 个 64 位通道，一次处理 256 位
+            const __m256i lut = _mm256_setr_epi8(
+                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low_mask = _mm256_set1_epi8(0x0f);
+            __m256i acc = _mm256_setzero_si256();
+            for (; i + 4 <= n; i += 4) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+                __m256i lo = _mm256_and_si256(v, low_mask);
+                __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+                __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+                acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+            }
+            total += static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1))
+                    + static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+#else
+            // 4 路独立累加，打破 popcnt 之间的依赖链
+            size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+            for (; i + 4 <= n; i += 4) {
+                c0 += detail::popcount64(w[i]);
+                c1 += detail::popcount64(w[i + 1]);
+                c2 += detail::popcount64(w[i + 2]);
+                c3 += detail::popcount64(w[i + 3]);
+            }
+            total = c0 + c1 + c2 + c3;
+#endif
+            for (; i < n; i++) {
+                total += detail::popcount64(w[i]);
+            }
+            return total;
+        }
+    };
+}
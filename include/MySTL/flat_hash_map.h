@@ -0,0 +1,575 @@
+#pragma once
+
+#include <cstddef>    // 引入size_t
+#include <cstdint>    // 引入int8_t、uint32_t
+#include <cstring>    // 引入memset、memcpy
+#include <functional> // 引入hash、equal_to
+#include <memory>     // 引入allocator_traits
+#include <new>
+#include <utility>    // 引入forward、move
+#include "algorithm.h"
+#include "allocator.h"
+#include "hash.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MySTL {
+
+    namespace detail {
+        // 控制字节：最高位为 1 表示空闲，为 0 时低 7 位保存哈希值的 h2 部分
+        using ctrl_t = int8_t;
+        constexpr ctrl_t ctrl_empty = -128;  // 0x80，从未使用
+        constexpr ctrl_t ctrl_deleted = -2;  // 0xFE，墓碑
+        constexpr ctrl_t ctrl_sentinel = -1; // 0xFF，只用于比较：小于它的都不是满槽
+
+        constexpr size_t group_width = 16;
+
+        inline uint32_t trailing_zeros16(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+            uint32_t n = 0;
+            while ((mask & 1) == 0) {
+                mask >>= 1;
+                n++;
+            }
+            return n;
+#endif
+        }
+
+        // 16 位掩码中从第 15 位往下数连续 0 的个数
+        inline uint32_t leading_zeros16(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<uint32_t>(__builtin_clz(mask)) - 16;
+#else
+            uint32_t n = 0;
+            for (uint32_t bit = 1u << 15; (mask & bit) == 0; bit >>= 1) {
+                n++;
+            }
+            return n;
+#endif
+        }
+
+        // 一次比较 16 个控制字节，结果为 16 位掩码，第 i 位对应第 i 个槽
+        class probe_group {
+        public:
+            explicit probe_group(const ctrl_t* ctrl) {
+#if defined(__SSE2__)
+                ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+                std::memcpy(ctrl_, ctrl, group_width);
+#endif
+            }
+
+            // h2 相同的槽
+            uint32_t match(ctrl_t h2) const {
+#if defined(__SSE2__)
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < group_width; i++) {
+                    mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+                }
+                return mask;
+#endif
+            }
+
+            uint32_t match_empty() const {
+                return match(ctrl_empty);
+            }
+
+            // 空闲或墓碑，即可以放入新元素的槽
+            uint32_t match_empty_or_deleted() const {
+#if defined(__SSE2__)
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl_)));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < group_width; i++) {
+                    mask |= static_cast<uint32_t>(ctrl_[i] < ctrl_sentinel) << i;
+                }
+                return mask;
+#endif
+            }
+
+        private:
+#if defined(__SSE2__)
+            __m128i ctrl_;
+#else
+            ctrl_t ctrl_[group_width];
+#endif
+        };
+    }
+
+    // 开放寻址哈希表（SwissTable 布局），接口与 unordered_map 基本一致
+    //   1. 元素直接存放在槽数组中，没有链表节点，查找不追指针
+    //   2. 每个槽对应 1 字节控制字节，保存哈希值的低 7 位（h2）；探测时一次比较 16 个控制字节（SSE2），
+    //      只有 h2 相同的槽才真正比较键，未命中通常只读一次控制字节组即可返回
+    //   3. 容量为 2 的幂，最大负载 7/8；控制字节数组尾部复制了前 16 个字节，从任意位置读取 16 字节都不会越界
+    //   4. 删除时如果该槽所在的连续满槽窗口不足 16 个，任何探测都不可能越过它，直接标为空闲，否则才留下墓碑
+    // 插入可能触发重新散列，会使所有迭代器和元素引用失效
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class flat_hash_map {
+        using ctrl_t = detail::ctrl_t;
+
+    public:
+        // 槽中保存的键值对，成员名与 unordered_map 的节点相同，it->key / it->value 的写法可以直接沿用
+        struct slot_type {
+            Key key;
+            T value;
+
+            template<typename K, typename... Args>
+            slot_type(K&& k, Args&&... args) : key(std::forward<K>(k)), value(std::forward<Args>(args)...) {}
+        };
+
+    private:
+        using slot_allocator = MySTL::allocator<slot_type>;
+        using ctrl_allocator = MySTL::allocator<ctrl_t>;
+        using slot_traits = std::allocator_traits<slot_allocator>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = slot_type;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        // ================== 迭代器实现 ==================
+        // 记录槽下标，++ 时跳过非满槽
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+            friend class flat_hash_map;
+
+            iterator(flat_hash_map* map, size_t index) : map_(map), index_(index) {}
+
+            slot_type& operator*() const { return map_->slots_[index_]; }
+            slot_type* operator->() const { return &map_->slots_[index_]; }
+
+            iterator& operator++() {
+                index_ = map_->next_full(index_ + 1);
+                return *this;
+            }
+
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+        private:
+            flat_hash_map* map_;
+            size_t index_;
+        };
+
+        class const_iterator {
+        public:
+            const_iterator(const flat_hash_map* map, size_t index) : map_(map), index_(index) {}
+
+            const_iterator(const iterator& other) : map_(other.map_), index_(other.index_) {}
+
+            const slot_type& operator*() const { return map_->slots_[index_]; }
+            const slot_type* operator->() const { return &map_->slots_[index_]; }
+
+            const_iterator& operator++() {
+                index_ = map_->next_full(index_ + 1);
+                return *this;
+            }
+
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+        private:
+            const flat_hash_map* map_;
+            size_t index_;
+        };
+
+        // 空表不分配内存，第一次插入时才分配 16 个槽
+        flat_hash_map() noexcept
+            : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0), hash_func_(), key_eq_() {}
+
+        explicit flat_hash_map(size_t n) : flat_hash_map() {
+            reserve(n);
+        }
+
+        ~flat_hash_map() {
+            destroy_all();
+            release(ctrl_, slots_, capacity_);
+        }
+
+        // ================== 五法则实现 ==================
+
+        flat_hash_map(const flat_hash_map& other)
+            : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+              hash_func_(other.hash_func_), key_eq_(other.key_eq_)
+        {
+            reserve(other.size_);
+            for (size_t i = 0; i < other.capacity_; i++) {
+                if (is_full(other.ctrl_[i])) {
+                    const slot_type& slot = other.slots_[i];
+                    size_t hash = hash_of(slot.key);
+                    emplace_at(find_first_non_full(hash), hash, slot.key, slot.value);
+                }
+            }
+        }
+
+        // 拷贝-交换：新表构造成功后才替换，异常时原表不变
+        flat_hash_map& operator=(const flat_hash_map& other) {
+            if (this != &other) {
+                flat_hash_map tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        flat_hash_map(flat_hash_map&& other) noexcept
+            : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+              growth_left_(other.growth_left_), hash_func_(std::move(other.hash_func_)),
+              key_eq_(std::move(other.key_eq_))
+        {
+            other.reset_state();
+        }
+
+        flat_hash_map& operator=(flat_hash_map&& other) noexcept {
+            if (this != &other) {
+                destroy_all();
+                release(ctrl_, slots_, capacity_);
+                ctrl_ = other.ctrl_;
+                slots_ = other.slots_;
+                capacity_ = other.capacity_;
+                size_ = other.size_;
+                growth_left_ = other.growth_left_;
+                hash_func_ = std::move(other.hash_func_);
+                key_eq_ = std::move(other.key_eq_);
+                other.reset_state();
+            }
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() { return iterator(this, next_full(0)); }
+        iterator end() { return iterator(this, capacity_); }
+        const_iterator begin() const { return const_iterator(this, next_full(0)); }
+        const_iterator end() const { return const_iterator(this, capacity_); }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return capacity_; }
+
+        float load_factor() const noexcept {
+            return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+        }
+
+        // ================== 查找 ==================
+        iterator find(const Key& key) {
+            return iterator(this, find_index(key));
+        }
+
+        const_iterator find(const Key& key) const {
+            return const_iterator(this, find_index(key));
+        }
+
+        size_t count(const Key& key) const {
+            return find_index(key) != capacity_ ? 1 : 0;
+        }
+
+        // ================== 插入 ==================
+        // 已存在时不覆盖，返回 false
+        bool insert(const Key& key, const T& value) {
+            return emplace(key, value);
+        }
+
+        // 第一个参数是键，其余参数用于构造值
+        template<typename K, typename... Args>
+        bool emplace(K&& key, Args&&... args) {
+            return try_emplace_impl(std::forward<K>(key), std::forward<Args>(args)...).second;
+        }
+
+        // 下标访问，如果不存在则默认初始化
+        // 插入可能重新散列，必须先拿到下标再读 slots_
+        T& operator[](const Key& key) {
+            size_t index = try_emplace_impl(key).first;
+            return slots_[index].value;
+        }
+
+        T& operator[](Key&& key) {
+            size_t index = try_emplace_impl(std::move(key)).first;
+            return slots_[index].value;
+        }
+
+        // ================== 删除 ==================
+        bool erase(const Key& key) {
+            size_t index = find_index(key);
+            if (index == capacity_) {
+                return false;
+            }
+            erase_at(index);
+            return true;
+        }
+
+        iterator erase(iterator pos) {
+            erase_at(pos.index_);
+            return iterator(this, next_full(pos.index_ + 1));
+        }
+
+        void clear() noexcept {
+            destroy_all();
+            if (capacity_ > 0) {
+                std::memset(ctrl_, detail::ctrl_empty, capacity_ + detail::group_width);
+            }
+            size_ = 0;
+            growth_left_ = max_load(capacity_);
+        }
+
+        // 保证容纳 n 个元素之前不会再重新散列
+        void reserve(size_t n) {
+            if (n == 0) {
+                return;
+            }
+            size_t cap = detail::group_width;
+            while (max_load(cap) < n) {
+                cap *= 2;
+            }
+            if (cap > capacity_) {
+                rehash_to(cap);
+            }
+        }
+
+        void swap(flat_hash_map& other) noexcept {
+            MySTL::swap(ctrl_, other.ctrl_);
+            MySTL::swap(slots_, other.slots_);
+            MySTL::swap(capacity_, other.capacity_);
+            MySTL::swap(size_, other.size_);
+            MySTL::swap(growth_left_, other.growth_left_);
+            MySTL::swap(hash_func_, other.hash_func_);
+            MySTL::swap(key_eq_, other.key_eq_);
+        }
+
+    private:
+        ctrl_t* ctrl_;        // capacity_ + 16 个控制字节，尾部 16 个是开头 16 个的副本
+        slot_type* slots_;    // capacity_ 个槽，只有控制字节为满的槽中有对象
+        size_t capacity_;     // 0 或不小于 16 的 2 的幂
+        size_t size_;
+        size_t growth_left_;  // 还能占用多少个空闲槽（墓碑不计入），为 0 时插入新元素需要重新散列
+        Hash hash_func_;
+        KeyEqual key_eq_;
+
+        static bool is_full(ctrl_t c) noexcept { return c >= 0; }
+
+        // 最大负载 7/8
+        static size_t max_load(size_t cap) noexcept { return cap - cap / 8; }
+
+        void reset_state() noexcept {
+            ctrl_ = nullptr;
+            slots_ = nullptr;
+            capacity_ = 0;
+            size_ = 0;
+            growth_left_ = 0;
+        }
+
+        size_t hash_of(const Key& key) const {
+            return MySTL::hash_mix(hash_func_(key));
+        }
+
+        // 高位决定探测起点，低 7 位存入控制字节
+        static size_t h1(size_t hash) noexcept { return hash >> 7; }
+        static ctrl_t h2(size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+        // 同时写入尾部的副本
+        void set_ctrl(size_t index, ctrl_t c) noexcept {
+            ctrl_[index] = c;
+            if (index < detail::group_width) {
+                ctrl_[capacity_ + index] = c;
+            }
+        }
+
+        size_t next_full(size_t index) const noexcept {
+            while (index < capacity_ && !is_full(ctrl_[index])) {
+                index++;
+            }
+            return index;
+        }
+
+        // 三角数步长探测：起点依次偏移 16、32、48……个槽，容量为 2 的幂时恰好遍历所有窗口
+        // 找不到时返回 capacity_
+        size_t find_index(const Key& key) const {
+            if (size_ == 0) {
+                return capacity_;
+            }
+            size_t hash = hash_of(key);
+            size_t mask = capacity_ - 1;
+            size_t pos = h1(hash) & mask;
+            for (size_t step = 0; step * detail::group_width < capacity_;) {
+                detail::probe_group group(ctrl_ + pos);
+                uint32_t match = group.match(h2(hash));
+                while (match != 0) {
+                    size_t index = (pos + detail::trailing_zeros16(match)) & mask;
+                    if (key_eq_(slots_[index].key, key)) {
+                        return index;
+                    }
+                    match &= match - 1;
+                }
+                // 窗口内有空闲槽，说明插入时探测到这里就停下了，键一定不存在
+                if (group.match_empty() != 0) {
+                    return capacity_;
+                }
+                step++;
+                pos = (pos + step * detail::group_width) & mask;
+            }
+            return capacity_;
+        }
+
+        // 探测序列上第一个空闲或墓碑槽，调用前保证存在
+        size_t find_first_non_full(size_t hash) const noexcept {
+            size_t mask = capacity_ - 1;
+            size_t pos = h1(hash) & mask;
+            for (size_t step = 0;;) {
+                uint32_t mask_free = detail::probe_group(ctrl_ + pos).match_empty_or_deleted();
+                if (mask_free != 0) {
+                    return (pos + detail::trailing_zeros16(mask_free)) & mask;
+                }
+                step++;
+                pos = (pos + step * detail::group_width) & mask;
+            }
+        }
+
+        // 返回 (槽下标, 是否新插入)
+        template<typename K, typename... Args>
+        std::pair<size_t, bool> try_emplace_impl(K&& key, Args&&... args) {
+            size_t index = find_index(key);
+            if (index != capacity_) {
+                return std::pair<size_t, bool>(index, false);
+            }
+            size_t hash = hash_of(key);
+            index = find_first_non_full_for_insert(hash);
+            emplace_at(index, hash, std::forward<K>(key), std::forward<Args>(args)...);
+            return std::pair<size_t, bool>(index, true);
+        }
+
+        // 必要时先扩容或清理墓碑，再找插入位置
+        size_t find_first_non_full_for_insert(size_t hash) {
+            if (capacity_ == 0) {
+                rehash_to(detail::group_width);
+                return find_first_non_full(hash);
+            }
+            size_t index = find_first_non_full(hash);
+            if (growth_left_ == 0 && ctrl_[index] != detail::ctrl_deleted) {
+                // 墓碑占了一半以上的可用容量时原地重建即可，否则翻倍
+                size_t cap = size_ * 2 < max_load(capacity_) ? capacity_ : capacity_ * 2;
+                rehash_to(cap);
+                index = find_first_non_full(hash);
+            }
+            return index;
+        }
+
+        template<typename... Args>
+        void emplace_at(size_t index, size_t hash, Args&&... args) {
+            slot_allocator alloc;
+            slot_traits::construct(alloc, slots_ + index, std::forward<Args>(args)...);
+            if (ctrl_[index] == detail::ctrl_empty) {
+                growth_left_--;
+            }
+            set_ctrl(index, h2(hash));
+            size_++;
+        }
+
+        void erase_at(size_t index) {
+            slot_allocator alloc;
+            slot_traits::destroy(alloc, slots_ + index);
+            size_--;
+            // 如果该槽前后连续的满槽（含墓碑）加起来不足 16 个，则任何 16 宽的探测窗口都会在它之前
+            // 遇到空闲槽而停止，不会有元素的探测序列需要越过这里，可以直接标记为空闲
+            size_t mask = capacity_ - 1;
+            size_t before = (index - detail::group_width) & mask;
+            uint32_t empty_after = detail::probe_group(ctrl_ + index).match_empty();
+            uint32_t empty_before = detail::probe_group(ctrl_ + before).match_empty();
+            bool was_never_full = empty_before != 0 && empty_after != 0
+                    && detail::trailing_zeros16(empty_after) + detail::leading_zeros16(empty_before) < detail::group_width;
+            if (was_never_full) {
+                set_ctrl(index, detail::ctrl_empty);
+                growth_left_++;
+            }
+            else {
+                set_ctrl(index, detail::ctrl_deleted);
+            }
+        }
+
+        void destroy_all() noexcept {
+            slot_allocator alloc;
+            for (size_t i = 0; i < capacity_; i++) {
+                if (is_full(ctrl_[i])) {
+                    slot_traits::destroy(alloc, slots_ + i);
+                }
+            }
+        }
+
+        static void release(ctrl_t* ctrl, slot_type* slots, size_t cap) noexcept {
+            if (cap == 0) {
+                return;
+            }
+            ctrl_allocator ctrl_alloc;
+            slot_allocator slot_alloc;
+            ctrl_alloc.deallocate(ctrl, cap + detail::group_width);
+            slot_alloc.deallocate(slots, cap);
+        }
+
+        // 分配新表并把所有元素搬过去，同时清除所有墓碑
+        // 元素的移动构造可能抛异常时改用拷贝，失败后原表保持不变
+        void rehash_to(size_t new_cap) {
+            ctrl_allocator ctrl_alloc;
+            slot_allocator slot_alloc;
+            ctrl_t* new_ctrl = ctrl_alloc.allocate(new_cap + detail::group_width);
+            slot_type* new_slots;
+            try {
+                new_slots = slot_alloc.allocate(new_cap);
+            }
+            catch (...) {
+                ctrl_alloc.deallocate(new_ctrl, new_cap + detail::group_width);
+                throw;
+            }
+            std::memset(new_ctrl, detail::ctrl_empty, new_cap + detail::group_width);
+
+            ctrl_t* old_ctrl = ctrl_;
+            slot_type* old_slots = slots_;
+            size_t old_cap = capacity_;
+            size_t old_size = size_;
+            size_t old_growth = growth_left_;
+
+            ctrl_ = new_ctrl;
+            slots_ = new_slots;
+            capacity_ = new_cap;
+            size_ = 0;
+            growth_left_ = max_load(new_cap);
+            try {
+                for (size_t i = 0; i < old_cap; i++) {
+                    if (is_full(old_ctrl[i])) {
+                        slot_type& slot = old_slots[i];
+                        size_t hash = hash_of(slot.key);
+                        emplace_at(find_first_non_full(hash), hash,
+                                   std::move_if_noexcept(slot.key), std::move_if_noexcept(slot.value));
+                    }
+                }
+            }
+            catch (...) {
+                destroy_all();
+                release(new_ctrl, new_slots, new_cap);
+                ctrl_ = old_ctrl;
+                slots_ = old_slots;
+                capacity_ = old_cap;
+                size_ = old_size;
+                growth_left_ = old_growth;
+                throw;
+            }
+            for (size_t i = 0; i < old_cap; i++) {
+                if (is_full(old_ctrl[i])) {
+                    slot_traits::destroy(slot_alloc, old_slots + i);
+                }
+            }
+            release(old_ctrl, old_slots, old_cap);
+        }
+    };
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>  // 引入stable_sort
+#include <cstddef>    // 引入size_t
+#include <functional> // 引入less
+#include <stdexcept>
+#include <utility>    // 引入pair、move
+#include "algorithm.h"
+#include "span.h"
+#include "vector.h"
+
+namespace MySTL {
+
+    // 基于有序数组的关联容器，适合读多写少的查找表
+    // 键和值分别存放在两个 MySTL::vector 中：查找时只扫描紧凑的键数组，缓存利用率远高于 rb_tree 的逐节点指针追逐，
+    // 并且全部元素只占两次分配
+    //   查找：无分支二分，O(log n)
+    //   单个插入/删除：O(n)（移动插入点之后的元素）
+    //   批量插入：先排序去重再与现有数据归并，O(n + k log k)
+    // 任何插入、删除都会使迭代器和引用失效
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class flat_map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using key_compare = Compare;
+        // 键和值不在同一个对象中，解引用得到的是两者引用组成的 pair
+        using reference = std::pair<const Key&, T&>;
+        using const_reference = std::pair<const Key&, const T&>;
+        using difference_type = std::ptrdiff_t;
+
+        // ================== 迭代器实现 ==================
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+            friend class flat_map;
+
+            // operator-> 需要返回指针语义，但 pair 是临时构造的，用一个代理对象包起来
+            struct arrow_proxy {
+                reference ref;
+                reference* operator->() { return &ref; }
+            };
+
+            iterator(flat_map* map, size_t index) : map_(map), index_(index) {}
+
+            reference operator*() const { return reference(map_->keys_[index_], map_->values_[index_]); }
+            arrow_proxy operator->() const { return arrow_proxy{**this}; }
+
+            iterator& operator++() { index_++; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            iterator& operator--() { index_--; return *this; }
+            iterator operator--(int) { iterator tmp = *this; --(*this); return tmp; }
+
+            iterator operator+(difference_type n) const { return iterator(map_, index_ + n); }
+            iterator operator-(difference_type n) const { return iterator(map_, index_ - n); }
+            difference_type operator-(const iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+        private:
+            flat_map* map_;
+            size_t index_;
+        };
+
+        class const_iterator {
+        public:
+            friend class flat_map;
+
+            struct arrow_proxy {
+                const_reference ref;
+                const_reference* operator->() { return &ref; }
+            };
+
+            const_iterator(const flat_map* map, size_t index) : map_(map), index_(index) {}
+
+            const_iterator(const iterator& other) : map_(other.map_), index_(other.index_) {}
+
+            const_reference operator*() const { return const_reference(map_->keys_[index_], map_->values_[index_]); }
+            arrow_proxy operator->() const { return arrow_proxy{**this}; }
+
+            const_iterator& operator++() { index_++; return *this; }
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            const_iterator& operator--() { index_--; return *this; }
+            const_iterator operator--(int) { const_iterator tmp = *this; --(*this); return tmp; }
+
+            const_iterator operator+(difference_type n) const { return const_iterator(map_, index_ + n); }
+            const_iterator operator-(difference_type n) const { return const_iterator(map_, index_ - n); }
+            difference_type operator-(const const_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+        private:
+            const flat_map* map_;
+            size_t index_;
+        };
+
+        flat_map() : keys_(), values_(), comp_() {}
+
+        explicit flat_map(const Compare& comp) : keys_(), values_(), comp_(comp) {}
+
+        // 从任意顺序的 (key, value) 序列批量构造：一次排序加一次去重，重复的键保留第一次出现的值
+        template<typename InputIt, typename = detail::require_iterator<InputIt>>
+        flat_map(InputIt first, InputIt last, const Compare& comp = Compare()) : keys_(), values_(), comp_(comp) {
+            insert(first, last);
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, keys_.size()); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, keys_.size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        size_t size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        void reserve(size_t n) {
+            keys_.reserve(n);
+            values_.reserve(n);
+        }
+
+        // 有序的键数组和与之一一对应的值数组
+        MySTL::span<const Key> keys() const noexcept { return MySTL::span<const Key>(keys_.data(), keys_.size()); }
+        MySTL::span<T> values() noexcept { return MySTL::span<T>(values_.data(), values_.size()); }
+        MySTL::span<const T> values() const noexcept { return MySTL::span<const T>(values_.data(), values_.size()); }
+
+        // ================== 查找 ==================
+        iterator lower_bound(const Key& key) { return iterator(this, lower_index(key)); }
+        const_iterator lower_bound(const Key& key) const { return const_iterator(this, lower_index(key)); }
+
+        iterator find(const Key& key) { return iterator(this, find_index(key)); }
+        const_iterator find(const Key& key) const { return const_iterator(this, find_index(key)); }
+
+        size_t count(const Key& key) const { return find_index(key) != keys_.size() ? 1 : 0; }
+        bool contains(const Key& key) const { return count(key) != 0; }
+
+        T& at(const Key& key) {
+            size_t i = find_index(key);
+            if (i == keys_.size()) {
+                throw std::out_of_range("flat_map::at: key not found");
+            }
+            return values_[i];
+        }
+
+        const T& at(const Key& key) const {
+            size_t i = find_index(key);
+            if (i == keys_.size()) {
+                throw std::out_of_range("flat_map::at: key not found");
+            }
+            return values_[i];
+        }
+
+        // 不存在时插入默认值
+        T& operator[](const Key& key) {
+            size_t i = lower_index(key);
+            if (i == keys_.size() || comp_(key, keys_[i])) {
+                insert_at(i, key, T());
+            }
+            return values_[i];
+        }
+
+        // ================== 插入 ==================
+        // 已存在相同的键时不覆盖，返回 false
+        std::pair<iterator, bool> insert(const Key& key, const T& value) {
+            size_t i = lower_index(key);
+            if (i < keys_.size() && !comp_(key, keys_[i])) {
+                return std::pair<iterator, bool>(iterator(this, i), false);
+            }
+            insert_at(i, key, value);
+            return std::pair<iterator, bool>(iterator(this, i), true);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& kv) {
+            return insert(kv.first, kv.second);
+        }
+
+        // 批量插入：把新数据排序去重后与现有数组做一次线性归并，而不是逐个插入
+        // 已存在的键保持原值；新数据中重复的键保留第一次出现的值
+        template<typename InputIt, typename = detail::require_iterator<InputIt>>
+        void insert(InputIt first, InputIt last) {
+            MySTL::vector<value_type> batch;
+            for (; first != last; ++first) {
+                batch.push_back(value_type(*first));
+            }
+            if (batch.empty()) {
+                return;
+            }
+            // 稳定排序，保证相同键中第一次出现的排在最前
+            std::stable_sort(batch.data(), batch.data() + batch.size(), [this](const value_type& a, const value_type& b) {
+                return comp_(a.first, b.first);
+            });
+
+            MySTL::vector<Key> new_keys;
+            MySTL::vector<T> new_values;
+            new_keys.reserve(keys_.size() + batch.size());
+            new_values.reserve(keys_.size() + batch.size());
+            size_t i = 0;
+            size_t j = 0;
+            while (i < keys_.size() || j < batch.size()) {
+                bool take_old;
+                if (j == batch.size()) {
+                    take_old = true;
+                }
+                else if (i == keys_.size()) {
+                    take_old = false;
+                }
+                else {
+                    take_old = !comp_(batch[j].first, keys_[i]);
+                }
+                if (take_old) {
+                    // 跳过新数据中与该键相同的项，已有的值优先
+                    while (j < batch.size() && !comp_(keys_[i], batch[j].first)) {
+                        j++;
+                    }
+                    // 已有元素的移动可能抛异常时改为拷贝，失败后 *this 保持不变
+                    new_keys.push_back(std::move_if_noexcept(keys_[i]));
+                    new_values.push_back(std::move_if_noexcept(values_[i]));
+                    i++;
+                }
+                else {
+                    new_keys.push_back(std::move(batch[j].first));
+                    new_values.push_back(std::move(batch[j].second));
+                    // 新数据内部去重
+                    size_t k = j + 1;
+                    while (k < batch.size() && !comp_(new_keys[new_keys.size() - 1], batch[k].first)) {
+                        k++;
+                    }
+                    j = k;
+                }
+            }
+            keys_.swap(new_keys);
+            values_.swap(new_values);
+        }
+
+        // ================== 删除 ==================
+        size_t erase(const Key& key) {
+            size_t i = find_index(key);
+            if (i == keys_.size()) {
+                return 0;
+            }
+            erase_at(i);
+            return 1;
+        }
+
+        iterator erase(const_iterator pos) {
+            erase_at(pos.index_);
+            return iterator(this, pos.index_);
+        }
+
+        void clear() noexcept {
+            keys_.clear();
+            values_.clear();
+        }
+
+        void swap(flat_map& other) noexcept {
+            keys_.swap(other.keys_);
+            values_.swap(other.values_);
+            MySTL::swap(comp_, other.comp_);
+        }
+
+    private:
+        MySTL::vector<Key> keys_;  // 有序、无重复
+        MySTL::vector<T> values_;  // values_[i] 对应 keys_[i]
+        Compare comp_;
+
+        size_t lower_index(const Key& key) const {
+            return MySTL::branchless_lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+        }
+
+        // 找不到时返回 size()
+        size_t find_index(const Key& key) const {
+            size_t i = lower_index(key);
+            if (i < keys_.size() && !comp_(key, keys_[i])) {
+                return i;
+            }
+            return keys_.size();
+        }
+
+        // 两个数组必须同时成功，值插入失败时撤销键的插入
+        void insert_at(size_t i, const Key& key, const T& value) {
+            keys_.insert(keys_.cbegin() + i, key);
+            try {
+                values_.insert(values_.cbegin() + i, value);
+            }
+            catch (...) {
+                keys_.erase(keys_.cbegin() + i);
+                throw;
+            }
+        }
+
+        void erase_at(size_t i) {
+            keys_.erase(keys_.cbegin() + i);
+            values_.erase(values_.cbegin() + i);
+        }
+    };
+}
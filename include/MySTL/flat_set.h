@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>  // 引入stable_sort
+#include <cstddef>    // 引入size_t
+#include <functional> // 引入less
+#include <utility>    // 引入pair、move
+#include "algorithm.h"
+#include "span.h"
+#include "vector.h"
+
+namespace MySTL {
+
+    // 基于有序数组的集合，与 flat_map 相同的思路：键紧密存放在一个 MySTL::vector 中，无分支二分查找
+    // 元素只读访问，迭代器即底层 vector 的 const_iterator；任何插入、删除都会使迭代器失效
+    template<typename Key, typename Compare = std::less<Key>>
+    class flat_set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using const_iterator = typename MySTL::vector<Key>::const_iterator;
+        using iterator = const_iterator;
+
+        flat_set() : keys_(), comp_() {}
+
+        explicit flat_set(const Compare& comp) : keys_(), comp_(comp) {}
+
+        // 从任意顺序的序列批量构造：一次排序加一次去重
+        template<typename InputIt, typename = detail::require_iterator<InputIt>>
+        flat_set(InputIt first, InputIt last, const Compare& comp = Compare()) : keys_(), comp_(comp) {
+            insert(first, last);
+        }
+
+        // ================== 迭代器访问 ==================
+        const_iterator begin() const noexcept { return keys_.cbegin(); }
+        const_iterator end() const noexcept { return keys_.cend(); }
+        const_iterator cbegin() const noexcept { return keys_.cbegin(); }
+        const_iterator cend() const noexcept { return keys_.cend(); }
+
+        size_t size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        void reserve(size_t n) { keys_.reserve(n); }
+
+        MySTL::span<const Key> keys() const noexcept { return MySTL::span<const Key>(keys_.data(), keys_.size()); }
+
+        // ================== 查找 ==================
+        const_iterator lower_bound(const Key& key) const { return begin() + lower_index(key); }
+
+        const_iterator find(const Key& key) const { return begin() + find_index(key); }
+
+        size_t count(const Key& key) const { return find_index(key) != keys_.size() ? 1 : 0; }
+        bool contains(const Key& key) const { return count(key) != 0; }
+
+        // ================== 插入 ==================
+        std::pair<const_iterator, bool> insert(const Key& key) {
+            size_t i = lower_index(key);
+            if (i < keys_.size() && !comp_(key, keys_[i])) {
+                return std::pair<const_iterator, bool>(begin() + i, false);
+            }
+            keys_.insert(keys_.cbegin() + i, key);
+            return std::pair<const_iterator, bool>(begin() + i, true);
+        }
+
+        // 批量插入：排序去重后与现有数组线性归并
+        template<typename InputIt, typename = detail::require_iterator<InputIt>>
+        void insert(InputIt first, InputIt last) {
+            MySTL::vector<Key> batch;
+            for (; first != last; ++first) {
+                batch.push_back(Key(*first));
+            }
+            if (batch.empty()) {
+                return;
+            }
+            std::stable_sort(batch.data(), batch.data() + batch.size(), comp_);
+
+            MySTL::vector<Key> merged;
+            merged.reserve(keys_.size() + batch.size());
+            size_t i = 0;
+            size_t j = 0;
+            while (i < keys_.size() || j < batch.size()) {
+                bool take_old = j == batch.size() || (i < keys_.size() && !comp_(batch[j], keys_[i]));
+                Key& next = take_old ? keys_[i++] : batch[j++];
+                // 与上一个写出的键相等则丢弃
+                if (merged.empty() || comp_(merged[merged.size() - 1], next)) {
+                    // 已有元素的移动可能抛异常时改为拷贝，失败后 *this 保持不变；batch 是局部的，可以直接移动
+                    if (take_old) {
+                        merged.push_back(std::move_if_noexcept(next));
+                    }
+                    else {
+                        merged.push_back(std::move(next));
+                    }
+                }
+            }
+            keys_.swap(merged);
+        }
+
+        // ================== 删除 ==================
+        size_t erase(const Key& key) {
+            size_t i = find_index(key);
+            if (i == keys_.size()) {
+                return 0;
+            }
+            keys_.erase(keys_.cbegin() + i);
+            return 1;
+        }
+
+        const_iterator erase(const_iterator pos) {
+            return keys_.erase(pos);
+        }
+
+        void clear() noexcept { keys_.clear(); }
+
+        void swap(flat_set& other) noexcept {
+            keys_.swap(other.keys_);
+            MySTL::swap(comp_, other.comp_);
+        }
+
+    private:
+        MySTL::vector<Key> keys_; // 有序、无重复
+        Compare comp_;
+
+        size_t lower_index(const Key& key) const {
+            return MySTL::branchless_lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+        }
+
+        size_t find_index(const Key& key) const {
+            size_t i = lower_index(key);
+            if (i < keys_.size() && !comp_(key, keys_[i])) {
+                return i;
+            }
+            return keys_.size();
+        }
+    };
+}
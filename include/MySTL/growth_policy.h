@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+
+namespace MySTL
+{
+    // 增长策略：容器需要扩容时调用
+    //     next_capacity(current, required, elem_size)
+    // current 为当前容量，required 为至少需要的元素个数，elem_size 为 sizeof(T)
+    // 返回值必须 >= required
+
+    // 2 倍增长，首次分配 8 个元素（vector 的默认行为）
+    struct grow_double
+    {
+        static size_t next_capacity(size_t current, size_t required, size_t)
+        {
+            size_t cap = current == 0 ? 8 : current * 2;
+            return cap < required ? required : cap;
+        }
+    };
+
+    // 1.5 倍增长：更省内存，且释放掉的旧块之和有机会被后续分配复用
+    struct grow_one_and_half
+    {
+        static size_t next_capacity(size_t current, size_t required, size_t)
+        {
+            size_t cap = current < 8 ? 8 : current + current / 2;
+            return cap < required ? required : cap;
+        }
+    };
+
+    // 在 Base 的基础上把字节数向上取整到整页，多出来的零头全部算作容量
+    // 适合与 mmap_allocator 搭配，mmap 本来就按页分配
+    template<typename Base = grow_double, size_t PageSize = 4096>
+    struct grow_page_rounded
+    {
+        static size_t next_capacity(
+                size_t current,
+                size_t required,
+                size_t elem_size)
+        {
+            size_t cap = Base::next_capacity(current, required, elem_size);
+            size_t bytes = (cap * elem_size + PageSize - 1) / PageSize * PageSize;
+            return bytes / elem_size;
+        }
+    };
+
+    // 容量不超过 Threshold 个元素时按 Base 增长，之后每次固定增加 Step 个
+    // 超大容器不会因为一次翻倍而突然多占用一倍内存
+    template<size_t Threshold, size_t Step, typename Base = grow_double>
+    struct grow_fixed_step
+    {
+        static_assert(Step > 0, "grow_fixed_step needs a positive step");
+
+        static size_t next_capacity(
+                size_t current,
+                size_t required,
+                size_t elem_size)
+        {
+            size_t cap = current < Threshold
+                    ? Base::next_capacity(current, required, elem_size)
+                    : current + Step;
+            return cap < required ? required : cap;
+        }
+    };
+} // namespace MySTL
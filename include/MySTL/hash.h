@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <cstdint> // 引入uint64_t
+
+namespace MySTL {
+
+    // 哈希值二次混合（MurmurHash3 的 fmix64 终结函数）
+    // std::hash 对整数通常是恒等映射，步长规律的键低位高度相关，
+    // 直接取低位作桶下标或控制字节会严重聚集；混合后每个输入位都会影响全部输出位
+    inline size_t hash_mix(size_t h) noexcept {
+        uint64_t x = static_cast<uint64_t>(h);
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+    }
+
+    // 桶下标策略：把哈希值映射到 [0, bucket_count)，并决定桶数如何取整
+    // 取模：桶数任意，每次定位一次整数除法（约 20~40 个周期），低位聚集的哈希直接体现为桶聚集
+    struct mod_bucket_policy {
+        static size_t bucket_count_for(size_t n) noexcept {
+            return n == 0 ? 1 : n;
+        }
+
+        static size_t index(size_t hash, size_t bucket_count) noexcept {
+            return hash % bucket_count;
+        }
+    };
+
+    // 2 的幂：桶数向上取整为 2 的幂，先 hash_mix 打散再按位与，定位只需几个周期
+    // 混合后步长规律的整数键也能均匀分布
+    struct pow2_bucket_policy {
+        static size_t bucket_count_for(size_t n) noexcept {
+            size_t count = 1;
+            while (count < n) {
+                count <<= 1;
+            }
+            return count;
+        }
+
+        static size_t index(size_t hash, size_t bucket_count) noexcept {
+            return hash_mix(hash) & (bucket_count - 1);
+        }
+    };
+}
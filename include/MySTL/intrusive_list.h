@@ -0,0 +1,459 @@
+#pragma once
+
+#include <cstddef>
+#include "algorithm.h"
+
+namespace MySTL
+{
+    // 侵入式链表的链接部分，由元素类型自己作为成员持有
+    // 拷贝元素时不拷贝链接关系：副本总是处于未链接状态
+    struct intrusive_list_hook
+    {
+        intrusive_list_hook *prev;
+        intrusive_list_hook *next;
+
+        intrusive_list_hook() noexcept: prev(nullptr), next(nullptr) {}
+        intrusive_list_hook(const intrusive_list_hook &) noexcept
+            : prev(nullptr), next(nullptr)
+        {
+        }
+        intrusive_list_hook &operator=(const intrusive_list_hook &) noexcept
+        {
+            return *this;
+        }
+
+        bool is_linked() const noexcept
+        {
+            return next != nullptr;
+        }
+    };
+
+    // 侵入式双向链表：不拥有元素，也不分配任何内存
+    // 元素通过成员 Hook 链入，push/insert/erase/splice 都只改指针，
+    // 持有元素指针即可 O(1) 把它从链表中摘下，适合在多个链表之间频繁搬移的池化对象:
+    //     struct Conn { int fd; MySTL::intrusive_list_hook hook; };
+    //     MySTL::intrusive_list<Conn, &Conn::hook> idle, busy;
+    //     busy.splice(busy.end(), idle, idle.iterator_to(conn));
+    // 元素的生命周期由使用者管理，销毁前必须先从链表中移除；
+    // 同一个 hook 同一时刻只能在一个链表中，需要同时在多个链表中时使用多个 hook 成员
+    // T 可以有虚函数、混合访问控制等，元素必须是完整的 T 对象（不能作为别的类的虚基类子对象链入）
+    template<typename T, intrusive_list_hook T::*Hook>
+    class intrusive_list
+    {
+        using hook_type = intrusive_list_hook;
+
+        // 哨兵嵌在链表对象内，与 list 相同，首尾相连成环
+        hook_type header_;
+        size_t size_;
+
+        static hook_type *hook_of(T &value) noexcept
+        {
+            return &(value.*Hook);
+        }
+
+        // hook 成员在 T 中的偏移量，每个 (T, Hook) 只在第一次调用时计算一次
+        // 在按 T 对齐的局部缓冲区上对成员指针求地址，只做地址运算，不读写缓冲区内容；
+        // 成员指针不能指向虚基类中的成员，因此计算不依赖虚表
+        static size_t hook_offset() noexcept
+        {
+            static const size_t offset = compute_hook_offset();
+            return offset;
+        }
+
+        static size_t compute_hook_offset() noexcept
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            T *p = reinterpret_cast<T *>(storage);
+            return static_cast<size_t>(
+                    reinterpret_cast<unsigned char *>(&(p->*Hook)) - storage);
+        }
+
+        // 由 hook 地址反推所在元素的地址
+        static T *owner_of(hook_type *hook) noexcept
+        {
+            return reinterpret_cast<T *>(
+                    reinterpret_cast<unsigned char *>(hook) - hook_offset());
+        }
+
+        static const T *owner_of(const hook_type *hook) noexcept
+        {
+            return reinterpret_cast<const T *>(
+                    reinterpret_cast<const unsigned char *>(hook) - hook_offset());
+        }
+
+        void init_header() noexcept
+        {
+            header_.prev = &header_;
+            header_.next = &header_;
+        }
+
+        // 接管 other 的全部元素，调用前 *this 必须为空
+        void steal(intrusive_list &other) noexcept
+        {
+            if (other.empty()) {
+                init_header();
+                size_ = 0;
+                return;
+            }
+            header_.next = other.header_.next;
+            header_.prev = other.header_.prev;
+            header_.next->prev = &header_;
+            header_.prev->next = &header_;
+            size_ = other.size_;
+            other.init_header();
+            other.size_ = 0;
+        }
+
+        static void link_before(hook_type *pos, hook_type *node) noexcept
+        {
+            node->prev = pos->prev;
+            node->next = pos;
+            pos->prev->next = node;
+            pos->prev = node;
+        }
+
+        // 摘下后把 hook 复位，is_linked() 随之变为 false
+        static void unlink_node(hook_type *node) noexcept
+        {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            node->prev = nullptr;
+            node->next = nullptr;
+        }
+
+        // 把 [first, last) 整段移到 pos 之前
+        static void transfer(hook_type *pos, hook_type *first, hook_type *last) noexcept
+        {
+            if (first == last || pos == last)
+                return;
+            hook_type *tail = last->prev;
+            first->prev->next = last;
+            last->prev = first->prev;
+            tail->next = pos;
+            first->prev = pos->prev;
+            pos->prev->next = first;
+            pos->prev = tail;
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator
+        {
+            friend class intrusive_list;
+            friend class const_iterator;
+            hook_type *node_;
+
+        public:
+            iterator(hook_type *n = nullptr): node_(n) {}
+
+            T &operator*() const
+            {
+                return *owner_of(node_);
+            }
+
+            T *operator->() const
+            {
+                return owner_of(node_);
+            }
+
+            iterator &operator++()
+            {
+                node_ = node_->next;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator tmp = *this;
+                node_ = node_->next;
+                return tmp;
+            }
+
+            iterator &operator--()
+            {
+                node_ = node_->prev;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator tmp = *this;
+                node_ = node_->prev;
+                return tmp;
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return node_ == rhs.node_;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return node_ != rhs.node_;
+            }
+        };
+
+        class const_iterator
+        {
+            friend class intrusive_list;
+            const hook_type *node_;
+
+        public:
+            const_iterator(const hook_type *n = nullptr): node_(n) {}
+
+            const_iterator(const iterator &it): node_(it.node_) {}
+
+            const T &operator*() const
+            {
+                return *owner_of(node_);
+            }
+
+            const T *operator->() const
+            {
+                return owner_of(node_);
+            }
+
+            const_iterator &operator++()
+            {
+                node_ = node_->next;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                node_ = node_->next;
+                return tmp;
+            }
+
+            const_iterator &operator--()
+            {
+                node_ = node_->prev;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator tmp = *this;
+                node_ = node_->prev;
+                return tmp;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return node_ == rhs.node_;
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return node_ != rhs.node_;
+            }
+        };
+
+        intrusive_list() noexcept: size_(0)
+        {
+            init_header();
+        }
+
+        // 析构只解除链接，不销毁元素
+        ~intrusive_list()
+        {
+            clear();
+        }
+
+        // 元素不属于链表，拷贝链表没有意义
+        intrusive_list(const intrusive_list &) = delete;
+        intrusive_list &operator=(const intrusive_list &) = delete;
+
+        intrusive_list(intrusive_list &&other) noexcept
+        {
+            steal(other);
+        }
+
+        intrusive_list &operator=(intrusive_list &&other) noexcept
+        {
+            if (this != &other) {
+                clear();
+                steal(other);
+            }
+            return *this;
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator(header_.next);
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(&header_);
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(header_.next);
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator(&header_);
+        }
+
+        // 由元素引用得到指向它的迭代器，O(1)，元素必须在本链表中
+        static iterator iterator_to(T &value) noexcept
+        {
+            return iterator(hook_of(value));
+        }
+
+        static bool is_linked(const T &value) noexcept
+        {
+            return (value.*Hook).is_linked();
+        }
+
+        size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        // 空链表上调用是未定义行为
+        T &front() noexcept
+        {
+            return *owner_of(header_.next);
+        }
+
+        T &back() noexcept
+        {
+            return *owner_of(header_.prev);
+        }
+
+        // 元素此时必须未链接到任何链表
+        void push_back(T &value) noexcept
+        {
+            link_before(&header_, hook_of(value));
+            ++size_;
+        }
+
+        void push_front(T &value) noexcept
+        {
+            link_before(header_.next, hook_of(value));
+            ++size_;
+        }
+
+        void pop_back() noexcept
+        {
+            if (empty())
+                return;
+            unlink_node(header_.prev);
+            --size_;
+        }
+
+        void pop_front() noexcept
+        {
+            if (empty())
+                return;
+            unlink_node(header_.next);
+            --size_;
+        }
+
+        // 在 pos 之前插入 value，返回指向它的迭代器
+        iterator insert(iterator pos, T &value) noexcept
+        {
+            hook_type *node = hook_of(value);
+            link_before(pos.node_, node);
+            ++size_;
+            return iterator(node);
+        }
+
+        // 摘下 pos 指向的元素，返回下一个元素的迭代器
+        iterator erase(iterator pos) noexcept
+        {
+            hook_type *node = pos.node_;
+            if (node == &header_)
+                return end(); // 不允许删哨兵
+            hook_type *next = node->next;
+            unlink_node(node);
+            --size_;
+            return iterator(next);
+        }
+
+        // 直接由元素摘下，O(1)，元素必须在本链表中
+        void erase(T &value) noexcept
+        {
+            erase(iterator_to(value));
+        }
+
+        // 摘下全部元素并复位它们的 hook
+        void clear() noexcept
+        {
+            hook_type *cur = header_.next;
+            while (cur != &header_) {
+                hook_type *next = cur->next;
+                cur->prev = nullptr;
+                cur->next = nullptr;
+                cur = next;
+            }
+            init_header();
+            size_ = 0;
+        }
+
+        void swap(intrusive_list &other) noexcept
+        {
+            MySTL::swap(header_.prev, other.header_.prev);
+            MySTL::swap(header_.next, other.header_.next);
+            MySTL::swap(size_, other.size_);
+            intrusive_list *both[2] = {this, &other};
+            for (intrusive_list *l : both) {
+                if (l->size_ == 0) {
+                    l->init_header();
+                }
+                else {
+                    l->header_.next->prev = &l->header_;
+                    l->header_.prev->next = &l->header_;
+                }
+            }
+        }
+
+        // ================== 在链表之间搬移 ==================
+        // 把 other 的全部元素移到 pos 之前，O(1)
+        void splice(iterator pos, intrusive_list &other) noexcept
+        {
+            if (this == &other || other.empty())
+                return;
+            transfer(pos.node_, other.header_.next, &other.header_);
+            size_ += other.size_;
+            other.size_ = 0;
+        }
+
+        // 把 other 中 it 指向的元素移到 pos 之前，O(1)
+        void splice(iterator pos, intrusive_list &other, iterator it) noexcept
+        {
+            hook_type *node = it.node_;
+            if (pos.node_ == node || pos.node_ == node->next)
+                return;
+            transfer(pos.node_, node, node->next);
+            ++size_;
+            --other.size_;
+        }
+
+        // 把 other 的 [first, last) 移到 pos 之前，n 为区间长度，O(1)
+        void splice(
+                iterator pos,
+                intrusive_list &other,
+                iterator first,
+                iterator last,
+                size_t n) noexcept
+        {
+            transfer(pos.node_, first.node_, last.node_);
+            if (this != &other) {
+                size_ += n;
+                other.size_ -= n;
+            }
+        }
+    };
+} // namespace MySTL
@@ -1,42 +1,167 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include "algorithm.h"
+#include "allocator.h"
 #include <utility>
 
 namespace MySTL
 {
-    template<typename T>
+    // Alloc 按节点类型 rebind 后使用，每次只申请一个节点
+    // 配合 memory_pool.h 中的 PoolAllocator，节点从固定大小的内存池中分配、释放后挂回自由链表，
+    // 频繁增删时不再进入 malloc，节点也集中在同一块内存里:
+    //     MemoryPool pool(MySTL::list<int>::node_size, 4096);
+    //     MySTL::list<int, PoolAllocator<int>> l{PoolAllocator<int>(pool)};
+    template<typename T, typename Alloc = MySTL::allocator<T>>
     class list
     {
+        // 链接部分单独作为基类，哨兵只需要它，不必包含 T
+        struct NodeBase
+        {
+            NodeBase *prev;
+            NodeBase *next;
+        };
+
         // 双向链表节点结构体
         // 类和结构体只有在没有定义 直接 构造函数时提供默认的无参构造
         // 即使定义了复制和移动构造，也还会提供无参构造
-        struct Node
+        // 元素由转发来的参数直接在节点内构造，不经过临时对象
+        struct Node: NodeBase
         {
             T data;
-            Node *prev;
-            Node *next;
-            Node(): prev(nullptr), next(nullptr) {}
-            Node(const T &value): data(value), prev(nullptr), next(nullptr) {}
+            template<typename... Args>
+            explicit Node(Args &&... args): data(std::forward<Args>(args)...)
+            {
+            }
         };
 
-        Node *head; // 首哨兵
-        Node *tail; // 尾哨兵
+        using node_allocator =
+                typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using node_alloc_traits = std::allocator_traits<node_allocator>;
+
+        // 哨兵直接嵌在 list 对象里，首尾相连成环：
+        // header_.next 指向首元素，header_.prev 指向尾元素，空链表时都指向自己
+        // 因此空链表、移动构造都不需要分配任何内存
+        NodeBase header_;
 
         size_t size_;
+        node_allocator alloc_;
+
+        template<typename... Args>
+        Node *create_node(Args &&... args)
+        {
+            Node *node = node_alloc_traits::allocate(alloc_, 1);
+            try {
+                node_alloc_traits::construct(alloc_, node, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                node_alloc_traits::deallocate(alloc_, node, 1);
+                throw;
+            }
+            return node;
+        }
+
+        void destroy_node(NodeBase *base) noexcept
+        {
+            Node *node = static_cast<Node *>(base);
+            node_alloc_traits::destroy(alloc_, node);
+            node_alloc_traits::deallocate(alloc_, node, 1);
+        }
+
+        void init_header() noexcept
+        {
+            header_.prev = &header_;
+            header_.next = &header_;
+        }
+
+        // 接管 other 的全部节点，调用前 *this 必须为空
+        void steal(list &other) noexcept
+        {
+            if (other.empty()) {
+                init_header();
+                size_ = 0;
+                return;
+            }
+            header_.next = other.header_.next;
+            header_.prev = other.header_.prev;
+            // 首尾节点原来指向 other 的哨兵，改为指向自己的
+            header_.next->prev = &header_;
+            header_.prev->next = &header_;
+            size_ = other.size_;
+            other.init_header();
+            other.size_ = 0;
+        }
+
+        // 把 node 链接到 pos 之前
+        static void link_before(NodeBase *pos, NodeBase *node) noexcept
+        {
+            node->prev = pos->prev;
+            node->next = pos;
+            pos->prev->next = node;
+            pos->prev = node;
+        }
+
+        static void unlink(NodeBase *node) noexcept
+        {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+        }
+
+        // 把 [first, last) 整段摘下并链接到 pos 之前，只改 6 个指针
+        // 调用者保证 pos 不在 [first, last) 中
+        static void transfer(NodeBase *pos, NodeBase *first, NodeBase *last) noexcept
+        {
+            if (first == last || pos == last)
+                return;
+            NodeBase *tail = last->prev;
+            first->prev->next = last;
+            last->prev = first->prev;
+            tail->next = pos;
+            first->prev = pos->prev;
+            pos->prev->next = first;
+            pos->prev = tail;
+        }
+
+        // 归并两条以 nullptr 结尾的单向有序链（只使用 next），相等时 a 在前，保证稳定
+        template<typename Compare>
+        static NodeBase *merge_runs(NodeBase *a, NodeBase *b, Compare &comp)
+        {
+            NodeBase head;
+            NodeBase *tail = &head;
+            while (a != nullptr && b != nullptr) {
+                if (comp(static_cast<Node *>(b)->data,
+                         static_cast<Node *>(a)->data)) {
+                    tail->next = b;
+                    b = b->next;
+                }
+                else {
+                    tail->next = a;
+                    a = a->next;
+                }
+                tail = tail->next;
+            }
+            tail->next = a != nullptr ? a : b;
+            return head.next;
+        }
 
     public:
+        using allocator_type = Alloc;
+
+        // 单个节点占用的字节数，用于按节点大小创建 MemoryPool
+        static constexpr size_t node_size = sizeof(Node);
+
         // 拷贝构造函数
-        list(const list &other): size_(0)
+        list(const list &other)
+            : size_(0),
+              alloc_(node_alloc_traits::select_on_container_copy_construction(
+                      other.alloc_))
         {
-            head = new Node();
-            tail = new Node();
-            head->next = tail;
-            tail->prev = head;
-            for (Node *cur = other.head->next; cur != other.tail;
+            init_header();
+            for (const NodeBase *cur = other.header_.next; cur != &other.header_;
                  cur = cur->next) {
-                push_back(cur->data);
+                push_back(static_cast<const Node *>(cur)->data);
             }
         }
 
@@ -44,11 +169,11 @@ namespace MySTL
         list &operator=(const list &other)
         {
             if (this == &other)
-                return this;
+                return *this;
             clear();
-            for (Node *cur = other.head->next; cur != other.tail;
+            for (const NodeBase *cur = other.header_.next; cur != &other.header_;
                  cur = cur->next) {
-                push_back(cur->data);
+                push_back(static_cast<const Node *>(cur)->data);
             }
             return *this;
         }
@@ -63,17 +188,11 @@ namespace MySTL
 
            移动构造如果能保证不会抛异常（比如只是指针交换），就应该加
            noexcept，这样容器才能安全高效地使用。
+           哨兵在对象内部，移动只需修正首尾节点的指针，不再为 other 重新分配哨兵
         */
-        list(list &&other) noexcept: head(nullptr), tail(nullptr), size_(0)
+        list(list &&other) noexcept: alloc_(std::move(other.alloc_))
         {
-            head = other.head;
-            tail = other.tail;
-            size_ = other.size_;
-            other.head = new Node();
-            other.tail = new Node();
-            other.head->next = other.tail;
-            other.tail->prev = other.head;
-            other.size_ = 0;
+            steal(other);
         }
 
         // 移动赋值操作符
@@ -81,32 +200,28 @@ namespace MySTL
         {
             if (this != &other) {
                 clear();
-                delete head; // 彻底变为nullptr，释放内存
-                delete tail;
-                head = other.head;
-                tail = other.tail;
-                size_ = other.size_;
-                other.head = new Node();
-                other.tail = new Node();
-                other.head->next = other.tail;
-                other.tail->prev = other.head;
-                other.size_ = 0;
+                // 连同分配器一起接管，因为这些节点将来要还给它
+                alloc_ = std::move(other.alloc_);
+                steal(other);
             }
             return *this;
         }
 
+        class const_iterator;
+
         class iterator
         {
             friend class list;
-            Node *node_;
+            friend class const_iterator;
+            NodeBase *node_;
 
         public:
-            iterator(Node *n = nullptr): node_(n) {}
+            iterator(NodeBase *n = nullptr): node_(n) {}
 
             // 解引用返回的必须是引用，对其修改是有效的
             T &operator*() const
             {
-                return node_->data;
+                return static_cast<Node *>(node_)->data;
             }
 
             // 当使用 it-> 时，实际上在使用 it.operator ->() ->
@@ -116,7 +231,7 @@ namespace MySTL
             // 自然，list 返回的指针必须能够直接访问 T 的内部结构
             T *operator->() const
             {
-                return &(node_->data);
+                return &(static_cast<Node *>(node_)->data);
             }
 
             // 前置++
@@ -160,33 +275,101 @@ namespace MySTL
             }
         };
 
+        // 只读迭代器，const list 的遍历使用
+        class const_iterator
+        {
+            friend class list;
+            const NodeBase *node_;
+
+        public:
+            const_iterator(const NodeBase *n = nullptr): node_(n) {}
+
+            const_iterator(const iterator &it): node_(it.node_) {}
+
+            const T &operator*() const
+            {
+                return static_cast<const Node *>(node_)->data;
+            }
+
+            const T *operator->() const
+            {
+                return &(static_cast<const Node *>(node_)->data);
+            }
+
+            const_iterator &operator++()
+            {
+                node_ = node_->next;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                node_ = node_->next;
+                return tmp;
+            }
+
+            const_iterator &operator--()
+            {
+                node_ = node_->prev;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator tmp = *this;
+                node_ = node_->prev;
+                return tmp;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return node_ == rhs.node_;
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return node_ != rhs.node_;
+            }
+        };
+
         iterator begin()
         {
-            return iterator(head->next);
+            return iterator(header_.next);
         }
 
         iterator end()
         {
-            return iterator(tail);
+            return iterator(&header_);
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(header_.next);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(&header_);
         }
 
         // 反向迭代器
         class reverse_iterator
         {
             friend class list;
-            Node *node_;
+            NodeBase *node_;
 
         public:
-            reverse_iterator(Node *n = nullptr): node_(n) {}
+            reverse_iterator(NodeBase *n = nullptr): node_(n) {}
 
             T &operator*() const
             {
-                return node_->data;
+                return static_cast<Node *>(node_)->data;
             }
 
             T *operator->() const
             {
-                return &(node_->data);
+                return &(static_cast<Node *>(node_)->data);
             }
 
             reverse_iterator &operator++()
@@ -228,47 +411,63 @@ namespace MySTL
 
         reverse_iterator rbegin()
         {
-            return reverse_iterator(tail->prev);
+            return reverse_iterator(header_.prev);
         }
 
         reverse_iterator rend()
         {
-            return reverse_iterator(head);
+            return reverse_iterator(&header_);
         }
 
-        list(): size_(0)
+        list() noexcept: size_(0), alloc_()
         {
-            head = new Node();
-            tail = new Node();
-            head->next = tail;
-            tail->prev = head;
+            init_header();
+        }
+
+        explicit list(const Alloc &alloc) noexcept: size_(0), alloc_(alloc)
+        {
+            init_header();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(alloc_);
         }
 
         ~list()
         {
             clear();
-            delete head;
-            delete tail;
         }
 
-        void clear()
+        void clear() noexcept
         {
-            Node *cur = head->next;
-            while (cur != tail) {
-                Node *tmp = cur;
+            NodeBase *cur = header_.next;
+            while (cur != &header_) {
+                NodeBase *tmp = cur;
                 cur = cur->next;
-                delete tmp;
+                destroy_node(tmp);
             }
-            head->next = tail;
-            tail->prev = head;
+            init_header();
             size_ = 0;
         }
 
+        // 交换首尾指针后，两边的首尾节点都要改为指向各自的哨兵
         void swap(list &other) noexcept
         {
-            MySTL::swap(head, other.head);
-            MySTL::swap(tail, other.tail);
+            MySTL::swap(header_.prev, other.header_.prev);
+            MySTL::swap(header_.next, other.header_.next);
             MySTL::swap(size_, other.size_);
+            MySTL::swap(alloc_, other.alloc_);
+            list *both[2] = {this, &other};
+            for (list *l : both) {
+                if (l->size_ == 0) {
+                    l->init_header();
+                }
+                else {
+                    l->header_.next->prev = &l->header_;
+                    l->header_.prev->next = &l->header_;
+                }
+            }
         }
 
         size_t size() const
@@ -281,34 +480,54 @@ namespace MySTL
             return size_ == 0;
         }
 
+        // 空链表上调用是未定义行为
+        T &front()
+        {
+            return static_cast<Node *>(header_.next)->data;
+        }
+
+        const T &front() const
+        {
+            return static_cast<const Node *>(header_.next)->data;
+        }
+
+        T &back()
+        {
+            return static_cast<Node *>(header_.prev)->data;
+        }
+
+        const T &back() const
+        {
+            return static_cast<const Node *>(header_.prev)->data;
+        }
+
         void push_back(const T &value)
         {
-            Node *node = new Node(value);
-            node->prev = tail->prev;
-            node->next = tail;
-            tail->prev = node;
-            tail->prev->next = node;
-            ++size_;
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
         }
 
         void push_front(const T &value)
         {
-            Node *node = new Node(value);
-            node->next = head->next;
-            node->prev = head;
-            head->next->prev = node;
-            head->next = node;
-            ++size_;
+            emplace_front(value);
+        }
+
+        void push_front(T &&value)
+        {
+            emplace_front(std::move(value));
         }
 
         void pop_back()
         {
             if (empty())
                 return;
-            Node *node = tail->prev;
-            node->prev->next = tail;
-            tail->prev = node->prev;
-            delete node;
+            NodeBase *node = header_.prev;
+            unlink(node);
+            destroy_node(node);
             --size_;
         }
 
@@ -316,23 +535,29 @@ namespace MySTL
         {
             if (empty())
                 return;
-            Node *node = head->next;
-            head->next = node->next;
-            node->next->prev = head;
-            delete node;
+            NodeBase *node = header_.next;
+            unlink(node);
+            destroy_node(node);
             --size_;
         }
 
         // 在 pos 位置前插入 value，返回新元素的迭代器
         iterator insert(iterator pos, const T &value)
         {
-            Node *cur = pos.node_;
-            Node *prev = cur->prev;
-            Node *node = new Node(value);
-            node->prev = prev;
-            node->next = cur;
-            prev->next = node;
-            cur->prev = node;
+            return emplace(pos, value);
+        }
+
+        iterator insert(iterator pos, T &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        // 在 pos 位置前用 args 直接构造新元素，返回新元素的迭代器
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&... args)
+        {
+            Node *node = create_node(std::forward<Args>(args)...);
+            link_before(pos.node_, node);
             ++size_;
             return iterator(node);
         }
@@ -340,14 +565,12 @@ namespace MySTL
         // 删除 pos 位置的元素，返回下一个元素的迭代器
         iterator erase(iterator pos)
         {
-            Node *node = pos.node_;
-            if (node == head || node == tail)
+            NodeBase *node = pos.node_;
+            if (node == &header_)
                 return end(); // 不允许删哨兵
-            Node *prev = node->prev;
-            Node *next = node->next;
-            prev->next = next;
-            next->prev = prev;
-            delete node;
+            NodeBase *next = node->next;
+            unlink(node);
+            destroy_node(node);
             --size_;
             return iterator(next);
         }
@@ -355,13 +578,187 @@ namespace MySTL
         template<typename... Args>
         void emplace_back(Args &&... args)
         {
-            Node *node = new Node(T(std::forward<Args>(args)...));
-            node->prev = tail->prev;
-            node->next = tail;
-            tail->prev->next = node;
-            tail->prev = node;
+            link_before(&header_, create_node(std::forward<Args>(args)...));
             ++size_;
         }
 
+        template<typename... Args>
+        void emplace_front(Args &&... args)
+        {
+            link_before(header_.next, create_node(std::forward<Args>(args)...));
+            ++size_;
+        }
+
+        // ================== 节点重链接操作 ==================
+        // 以下操作都只修改节点指针，不分配、不拷贝也不移动元素，
+        // 因此对不可移动的大对象同样适用，原有迭代器仍然指向原来的元素。
+        // 在两个链表之间转移节点时要求二者的分配器相等，节点将来由 *this 的分配器释放
+
+        // 把 other 的全部元素移到 pos 之前，O(1)
+        void splice(iterator pos, list &other) noexcept
+        {
+            if (this == &other || other.empty())
+                return;
+            transfer(pos.node_, other.header_.next, &other.header_);
+            size_ += other.size_;
+            other.size_ = 0;
+        }
+
+        void splice(iterator pos, list &&other) noexcept
+        {
+            splice(pos, other);
+        }
+
+        // 把 other 中 it 指向的单个元素移到 pos 之前，O(1)
+        void splice(iterator pos, list &other, iterator it) noexcept
+        {
+            NodeBase *node = it.node_;
+            if (pos.node_ == node || pos.node_ == node->next)
+                return;
+            transfer(pos.node_, node, node->next);
+            ++size_;
+            --other.size_;
+        }
+
+        // 把 other 的 [first, last) 移到 pos 之前，n 为区间长度，O(1)
+        // 调用者通常在构造区间时就知道长度，直接传入可以省去计数
+        void splice(
+                iterator pos,
+                list &other,
+                iterator first,
+                iterator last,
+                size_t n) noexcept
+        {
+            transfer(pos.node_, first.node_, last.node_);
+            if (this != &other) {
+                size_ += n;
+                other.size_ -= n;
+            }
+        }
+
+        // 同上，区间长度需要逐个数出来：同一链表内 O(1)，跨链表 O(n)
+        void splice(iterator pos, list &other, iterator first, iterator last) noexcept
+        {
+            size_t n = this == &other
+                    ? 0
+                    : static_cast<size_t>(MySTL::distance(first, last));
+            splice(pos, other, first, last, n);
+        }
+
+        // 归并两个有序链表，结果留在 *this 中，other 变为空；相等元素中 *this 的在前
+        template<typename Compare>
+        void merge(list &other, Compare comp)
+        {
+            if (this == &other)
+                return;
+            NodeBase *cur = header_.next;
+            // 循环中不更新 size_，用 other 的哨兵判断是否已取完
+            while (cur != &header_ && other.header_.next != &other.header_) {
+                NodeBase *node = other.header_.next;
+                if (comp(static_cast<Node *>(node)->data,
+                         static_cast<Node *>(cur)->data)) {
+                    transfer(cur, node, node->next);
+                }
+                else {
+                    cur = cur->next;
+                }
+            }
+            transfer(&header_, other.header_.next, &other.header_);
+            size_ += other.size_;
+            other.size_ = 0;
+        }
+
+        void merge(list &other)
+        {
+            merge(other, std::less<T>());
+        }
+
+        // 自底向上的稳定归并排序，O(n log n)，只重链接节点
+        // 先拆成以 nullptr 结尾的单链，bins[i] 暂存长度为 2^i 的有序段，
+        // 新元素像二进制加法进位一样逐级归并，最后把各段合并并补回 prev 指针
+        template<typename Compare>
+        void sort(Compare comp)
+        {
+            if (size_ < 2)
+                return;
+            NodeBase *bins[64] = {};
+            header_.prev->next = nullptr;
+            NodeBase *cur = header_.next;
+            while (cur != nullptr) {
+                NodeBase *next = cur->next;
+                cur->next = nullptr;
+                NodeBase *run = cur;
+                size_t i = 0;
+                for (; bins[i] != nullptr; ++i) {
+                    // bins[i] 中的元素原本在前，放在 a 的位置以保持稳定
+                    run = merge_runs(bins[i], run, comp);
+                    bins[i] = nullptr;
+                }
+                bins[i] = run;
+                cur = next;
+            }
+            NodeBase *result = nullptr;
+            for (size_t i = 0; i < 64; ++i) {
+                if (bins[i] != nullptr) {
+                    result = result == nullptr ? bins[i]
+                                               : merge_runs(bins[i], result, comp);
+                }
+            }
+            NodeBase *prev = &header_;
+            for (NodeBase *node = result; node != nullptr; node = node->next) {
+                node->prev = prev;
+                prev->next = node;
+                prev = node;
+            }
+            prev->next = &header_;
+            header_.prev = prev;
+        }
+
+        void sort()
+        {
+            sort(std::less<T>());
+        }
+
+        // 逆序：交换每个节点（包括哨兵）的 prev 和 next
+        void reverse() noexcept
+        {
+            NodeBase *node = &header_;
+            do {
+                MySTL::swap(node->prev, node->next);
+                node = node->prev; // 交换后 prev 是原来的 next
+            } while (node != &header_);
+        }
+
+        // 删除相邻的重复元素，只保留每组的第一个，返回删除的个数
+        template<typename BinaryPredicate>
+        size_t unique(BinaryPredicate pred)
+        {
+            size_t removed = 0;
+            if (size_ < 2)
+                return removed;
+            NodeBase *keep = header_.next;
+            NodeBase *cur = keep->next;
+            while (cur != &header_) {
+                NodeBase *next = cur->next;
+                if (pred(static_cast<Node *>(keep)->data,
+                         static_cast<Node *>(cur)->data)) {
+                    unlink(cur);
+                    destroy_node(cur);
+                    --size_;
+                    ++removed;
+                }
+                else {
+                    keep = cur;
+                }
+                cur = next;
+            }
+            return removed;
+        }
+
+        size_t unique()
+        {
+            return unique(std::equal_to<T>());
+        }
+
     };
-} // namespace MySTL
\ No newline at end of file
+} // namespace MySTL
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <cstring> // 引入memcpy
+#include <new>     // 引入bad_alloc
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace MySTL
+{
+    // 直接向内核要匿名页的分配器，只适合大块内存（最少占一页）
+    //
+    // 额外提供 reallocate：Linux 上通过 mremap 改变映射大小，内核只改页表，
+    // 不复制数据，也不会同时占用新旧两份物理内存。
+    // vector 在元素可平凡重定位时会检测到这个成员，扩容改走 reallocate。
+    // 建议与 grow_page_rounded 一起使用，让容量正好占满整页。
+    template<typename T>
+    class mmap_allocator
+    {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        mmap_allocator() noexcept = default;
+
+        template<typename U>
+        mmap_allocator(const mmap_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            void* p = ::mmap(
+                    nullptr, bytes(n), PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(p);
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            ::munmap(p, bytes(n));
+        }
+
+        // 把 [p, p + old_n) 所在的映射调整为能容纳 new_n 个元素，返回新地址
+        // 内容按字节原样保留，因此只能用于可平凡重定位的类型
+        T* reallocate(T* p, size_t old_n, size_t new_n)
+        {
+#ifdef __linux__
+            void* q = ::mremap(p, bytes(old_n), bytes(new_n), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(q);
+#else
+            // 没有 mremap 的平台退化为 分配 + 拷贝 + 释放
+            T* q = allocate(new_n);
+            size_t n = old_n < new_n ? old_n : new_n;
+            std::memcpy(
+                    static_cast<void*>(q), static_cast<const void*>(p),
+                    n * sizeof(T));
+            deallocate(p, old_n);
+            return q;
+#endif
+        }
+
+    private:
+        static size_t bytes(size_t n)
+        {
+            static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            return (n * sizeof(T) + page - 1) / page * page;
+        }
+    };
+
+    template<typename T, typename U>
+    bool operator==(const mmap_allocator<T>&, const mmap_allocator<U>&) noexcept
+    {
+        return true;
+    }
+
+    template<typename T, typename U>
+    bool operator!=(const mmap_allocator<T>&, const mmap_allocator<U>&) noexcept
+    {
+        return false;
+    }
+} // namespace MySTL
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef> // 引入size_t
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility> // 引入forward
+#include "growth_policy.h"
+#include "vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MySTL {
+
+    // 以文件为后备存储的 vector，元素直接位于 mmap 映射的页中
+    //   1. 打开已有文件不拷贝任何数据，启动时间与文件大小无关，页面按需由内核换入换出
+    //   2. 扩容通过 ftruncate 延长文件，再用 mremap（非 Linux 为重新 mmap）扩大映射
+    //   3. flush() 调用 msync 把脏页写回磁盘
+    //   4. 只读模式使用写时复制的私有映射：元素仍可修改，但只改本进程的副本，不会写回文件
+    // 文件内容就是元素数组本身，没有额外的头部，因此 T 必须是平凡可拷贝的。
+    // 打开期间文件长度等于容量，close()/析构时截断为 size() * sizeof(T)。
+    // 迭代器与 MySTL::vector<T> 相同，原有基于 vector 迭代器的代码可直接使用。
+    template<typename T, typename Growth = MySTL::grow_page_rounded<MySTL::grow_double>>
+    class mmap_vector {
+        static_assert(std::is_trivially_copyable<T>::value, "mmap_vector requires a trivially copyable T");
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+
+        using iterator = typename MySTL::vector<T>::iterator;
+        using const_iterator = typename MySTL::vector<T>::const_iterator;
+
+        enum class open_mode {
+            read_only,  // 文件以只读打开；修改元素只影响私有副本，改变大小抛 logic_error
+            read_write, // 打开已有文件（不存在则创建）
+            truncate    // 创建或清空文件
+        };
+
+        mmap_vector() noexcept : fd_(-1), data_(nullptr), size_(0), capacity_(0), writable_(false) {}
+
+        mmap_vector(const std::string& path, open_mode mode) : mmap_vector() {
+            open(path, mode);
+        }
+
+        ~mmap_vector() {
+            try {
+                close();
+            }
+            catch (...) {
+                // 析构函数不能抛异常，截断失败时文件尾部会留有未使用的容量
+            }
+        }
+
+        // 映射和文件描述符都是独占资源，只允许移动
+        mmap_vector(const mmap_vector&) = delete;
+        mmap_vector& operator=(const mmap_vector&) = delete;
+
+        mmap_vector(mmap_vector&& other) noexcept
+            : fd_(other.fd_), data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+              writable_(other.writable_)
+        {
+            other.reset_state();
+        }
+
+        mmap_vector& operator=(mmap_vector&& other) {
+            if (this != &other) {
+                close();
+                fd_ = other.fd_;
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                writable_ = other.writable_;
+                other.reset_state();
+            }
+            return *this;
+        }
+
+        void open(const std::string& path, open_mode mode) {
+            close();
+            int flags = mode == open_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+            if (mode == open_mode::truncate) {
+                flags |= O_TRUNC;
+            }
+            int fd = ::open(path.c_str(), flags, 0644);
+            if (fd < 0) {
+                throw_errno("mmap_vector: open failed: " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "mmap_vector: fstat failed: " + path);
+            }
+            size_t bytes = static_cast<size_t>(st.st_size);
+            if (bytes % sizeof(T) != 0) {
+                ::close(fd);
+                throw std::runtime_error("mmap_vector: file size is not a multiple of sizeof(T): " + path);
+            }
+            fd_ = fd;
+            writable_ = mode != open_mode::read_only;
+            size_ = bytes / sizeof(T);
+            capacity_ = size_;
+            if (capacity_ > 0) {
+                data_ = map(capacity_);
+            }
+        }
+
+        bool is_open() const noexcept { return fd_ >= 0; }
+
+        // 写回脏页并把文件截断到实际大小，然后解除映射
+        void close() {
+            if (fd_ < 0) {
+                return;
+            }
+            if (writable_) {
+                flush();
+            }
+            if (data_ != nullptr) {
+                ::munmap(data_, capacity_ * sizeof(T));
+            }
+            int err = 0;
+            if (writable_ && ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))) != 0) {
+                err = errno;
+            }
+            ::close(fd_);
+            reset_state();
+            if (err != 0) {
+                throw std::system_error(err, std::generic_category(), "mmap_vector: ftruncate failed");
+            }
+        }
+
+        // 同步写回磁盘，返回时数据已持久化
+        void flush() {
+            if (data_ != nullptr && writable_ && ::msync(data_, capacity_ * sizeof(T), MS_SYNC) != 0) {
+                throw_errno("mmap_vector: msync failed");
+            }
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(data_); }
+        iterator end() noexcept { return iterator(data_ + size_); }
+        const_iterator begin() const noexcept { return const_iterator(data_); }
+        const_iterator end() const noexcept { return const_iterator(data_ + size_); }
+        const_iterator cbegin() const noexcept { return const_iterator(data_); }
+        const_iterator cend() const noexcept { return const_iterator(data_ + size_); }
+
+        pointer data() noexcept { return data_; }
+        const_pointer data() const noexcept { return data_; }
+
+        size_t size() const noexcept { return size_; }
+        size_t capacity() const noexcept { return capacity_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        void reserve(size_t new_capacity) {
+            check_writable();
+            if (new_capacity <= capacity_) {
+                return;
+            }
+            if (::ftruncate(fd_, static_cast<off_t>(new_capacity * sizeof(T))) != 0) {
+                throw_errno("mmap_vector: ftruncate failed");
+            }
+            data_ = remap(new_capacity);
+            capacity_ = new_capacity;
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            check_writable();
+            if (size_ == capacity_) {
+                reserve(Growth::next_capacity(capacity_, size_ + 1, sizeof(T)));
+            }
+            new(&data_[size_]) value_type(std::forward<Args>(args)...);
+            size_++;
+        }
+
+        void pop_back() {
+            check_writable();
+            if (size_ > 0) {
+                size_--;
+            }
+        }
+
+        // 扩大时新元素值初始化（清零）；文件延长部分本来就是 0，这里只是显式保证
+        void resize(size_t new_size) {
+            check_writable();
+            if (new_size > capacity_) {
+                reserve(Growth::next_capacity(capacity_, new_size, sizeof(T)));
+            }
+            for (size_t i = size_; i < new_size; i++) {
+                new(&data_[i]) value_type();
+            }
+            size_ = new_size;
+        }
+
+        void clear() {
+            check_writable();
+            size_ = 0;
+        }
+
+        reference operator[](size_t index) { return data_[index]; }
+        const_reference operator[](size_t index) const { return data_[index]; }
+
+        reference at(size_t index) {
+            if (index >= size_) {
+                throw std::out_of_range("mmap_vector::at: index out of range");
+            }
+            return data_[index];
+        }
+
+        const_reference at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("mmap_vector::at: index out of range");
+            }
+            return data_[index];
+        }
+
+    private:
+        int fd_;
+        pointer data_;
+        size_t size_;
+        size_t capacity_; // 以元素计，等于当前文件长度和映射长度
+        bool writable_;
+
+        void reset_state() noexcept {
+            fd_ = -1;
+            data_ = nullptr;
+            size_ = 0;
+            capacity_ = 0;
+            writable_ = false;
+        }
+
+        static void throw_errno(const std::string& what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        void check_writable() const {
+            if (!writable_) {
+                throw std::logic_error("mmap_vector: not opened for writing");
+            }
+        }
+
+        // 只读时用 MAP_PRIVATE：页面可写（写时复制），非 const 访问器返回的引用写入也不会触发 SIGSEGV
+        pointer map(size_t n) {
+            int flags = writable_ ? MAP_SHARED : MAP_PRIVATE;
+            void* p = ::mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, flags, fd_, 0);
+            if (p == MAP_FAILED) {
+                throw_errno("mmap_vector: mmap failed");
+            }
+            return static_cast<pointer>(p);
+        }
+
+        // 调用前文件已经延长到 n 个元素
+        pointer remap(size_t n) {
+            if (data_ == nullptr) {
+                return map(n);
+            }
+#ifdef __linux__
+            void* p = ::mremap(data_, capacity_ * sizeof(T), n * sizeof(T), MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) {
+                throw_errno("mmap_vector: mremap failed");
+            }
+            return static_cast<pointer>(p);
+#else
+            // 共享映射的内容就在文件里，直接重新映射即可，无需拷贝
+            pointer p = map(n);
+            ::munmap(data_, capacity_ * sizeof(T));
+            return p;
+#endif
+        }
+    };
+}
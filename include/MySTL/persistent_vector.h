@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <memory>  // 引入shared_ptr
+#include <new>
+#include <stdexcept>
+#include <utility> // 引入forward、move
+#include "algorithm.h"
+
+namespace MySTL {
+
+    // 持久化（不可变）vector：32 叉前缀树 + 尾部缓冲，不同版本之间共享未修改的节点
+    //   拷贝（快照）：只复制根和尾部两个 shared_ptr，O(1)
+    //   push_back / set / pop_back：只复制从根到目标叶子的一条路径，O(log32 n)，每层最多复制 32 个指针
+    //   下标访问：O(log32 n)，一百万元素也只有 4 层
+    // 新元素先写入尾部缓冲，满 32 个再整块挂入树中，因此 push_back 大多数情况下不碰树
+    //
+    // 修改操作作用于当前对象本身，但从不改动已有节点，之前拷贝出去的快照始终保持原样。
+    // 节点引用计数是原子的，各线程持有各自的 persistent_vector 对象即可并发读取，无需加锁；
+    // 同一个对象的并发读写仍需外部同步（例如用 std::atomic_store 发布指向新版本的 shared_ptr）
+    template<typename T>
+    class persistent_vector {
+        static constexpr size_t bits = 5;
+        static constexpr size_t width = size_t(1) << bits;
+        static constexpr size_t mask = width - 1;
+
+        struct node {};
+
+        // 内部节点：32 个子节点指针，未使用的为空
+        struct branch : node {
+            std::shared_ptr<const node> children[width];
+        };
+
+        // 叶子节点：最多 32 个元素，连续存放
+        struct leaf : node {
+            size_t count;
+            alignas(T) unsigned char buffer[width * sizeof(T)];
+
+            leaf() noexcept : count(0) {}
+
+            leaf(const leaf& other) : count(0) {
+                try {
+                    for (; count < other.count; count++) {
+                        new(data() + count) T(other.data()[count]);
+                    }
+                }
+                catch (...) {
+                    destroy();
+                    throw;
+                }
+            }
+
+            leaf& operator=(const leaf&) = delete;
+
+            ~leaf() { destroy(); }
+
+            T* data() noexcept { return reinterpret_cast<T*>(buffer); }
+            const T* data() const noexcept { return reinterpret_cast<const T*>(buffer); }
+
+            void destroy() noexcept {
+                while (count > 0) {
+                    count--;
+                    data()[count].~T();
+                }
+            }
+        };
+
+        using node_ptr = std::shared_ptr<const node>;
+        using leaf_ptr = std::shared_ptr<const leaf>;
+
+    public:
+        using value_type = T;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+
+        // ================== 迭代器实现 ==================
+        // 元素不可经由迭代器修改；迭代器缓存当前叶子，每 32 个元素才走一次树
+        class const_iterator {
+        public:
+            const_iterator(const persistent_vector* vec, size_t index)
+                : vec_(vec), index_(index), leaf_(index < vec->size_ ? vec->leaf_for(index) : nullptr) {}
+
+            const_reference operator*() const { return leaf_[index_ & mask]; }
+            const T* operator->() const { return &leaf_[index_ & mask]; }
+
+            const_iterator& operator++() {
+                index_++;
+                if ((index_ & mask) == 0 && index_ < vec_->size_) {
+                    leaf_ = vec_->leaf_for(index_);
+                }
+                return *this;
+            }
+
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            const_iterator& operator--() {
+                if ((index_ & mask) == 0 || index_ == vec_->size_) {
+                    leaf_ = vec_->leaf_for(index_ - 1);
+                }
+                index_--;
+                return *this;
+            }
+
+            const_iterator operator--(int) { const_iterator tmp = *this; --(*this); return tmp; }
+
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+            size_t index() const { return index_; }
+
+        private:
+            const persistent_vector* vec_;
+            size_t index_;
+            const T* leaf_; // 当前元素所在叶子的首地址
+        };
+
+        using iterator = const_iterator;
+
+        persistent_vector() noexcept : root_(), tail_(), size_(0), shift_(bits) {}
+
+        template<typename InputIt>
+        persistent_vector(InputIt first, InputIt last) : persistent_vector() {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        // 拷贝即快照，只增加两个引用计数；移动、析构等均由 shared_ptr 完成
+        persistent_vector(const persistent_vector&) = default;
+        persistent_vector& operator=(const persistent_vector&) = default;
+
+        persistent_vector(persistent_vector&& other) noexcept
+            : root_(std::move(other.root_)), tail_(std::move(other.tail_)), size_(other.size_), shift_(other.shift_)
+        {
+            other.size_ = 0;
+            other.shift_ = bits;
+        }
+
+        persistent_vector& operator=(persistent_vector&& other) noexcept {
+            if (this != &other) {
+                root_ = std::move(other.root_);
+                tail_ = std::move(other.tail_);
+                size_ = other.size_;
+                shift_ = other.shift_;
+                other.size_ = 0;
+                other.shift_ = bits;
+            }
+            return *this;
+        }
+
+        // 返回当前版本的快照，之后对 *this 的修改不会影响它
+        persistent_vector snapshot() const { return *this; }
+
+        // ================== 迭代器访问 ==================
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size_); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        const_reference operator[](size_t index) const { return leaf_for(index)[index & mask]; }
+
+        const_reference at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("persistent_vector::at: index out of range");
+            }
+            return (*this)[index];
+        }
+
+        const_reference front() const { return (*this)[0]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        // ================== 修改（路径复制） ==================
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            if (size_ - tail_offset() < width) {
+                // 尾部还有空位：复制尾部并追加
+                std::shared_ptr<leaf> new_tail = copy_leaf(tail_.get());
+                new(new_tail->data() + new_tail->count) T(std::forward<Args>(args)...);
+                new_tail->count++;
+                tail_ = std::move(new_tail);
+                size_++;
+                return;
+            }
+            // 尾部已满：先构造新尾部，再把旧尾部挂入树中，任何一步抛异常都不改变当前对象
+            std::shared_ptr<leaf> new_tail = std::make_shared<leaf>();
+            new(new_tail->data()) T(std::forward<Args>(args)...);
+            new_tail->count = 1;
+
+            node_ptr new_root;
+            size_t new_shift = shift_;
+            if ((size_ >> bits) > (size_t(1) << shift_)) {
+                // 根已满，树长高一层
+                std::shared_ptr<branch> grown = std::make_shared<branch>();
+                grown->children[0] = root_;
+                grown->children[1] = new_path(shift_, tail_);
+                new_root = std::move(grown);
+                new_shift += bits;
+            }
+            else {
+                new_root = push_tail(shift_, static_cast<const branch*>(root_.get()), tail_);
+            }
+            root_ = std::move(new_root);
+            shift_ = new_shift;
+            tail_ = std::move(new_tail);
+            size_++;
+        }
+
+        void set(size_t index, const T& value) {
+            if (index >= size_) {
+                throw std::out_of_range("persistent_vector::set: index out of range");
+            }
+            if (index >= tail_offset()) {
+                std::shared_ptr<leaf> new_tail = copy_leaf(tail_.get());
+                new_tail->data()[index & mask] = value;
+                tail_ = std::move(new_tail);
+                return;
+            }
+            root_ = assoc(shift_, root_.get(), index, value);
+        }
+
+        void pop_back() {
+            if (size_ == 0) {
+                return;
+            }
+            if (size_ == 1) {
+                clear();
+                return;
+            }
+            if (size_ - tail_offset() > 1) {
+                std::shared_ptr<leaf> new_tail = copy_leaf(tail_.get());
+                new_tail->count--;
+                new_tail->data()[new_tail->count].~T();
+                tail_ = std::move(new_tail);
+                size_--;
+                return;
+            }
+            // 尾部只剩一个元素：把树中最后一个叶子取出来作为新的尾部
+            leaf_ptr new_tail = leaf_node_for(size_ - 2);
+            node_ptr new_root = pop_tail(shift_, static_cast<const branch*>(root_.get()));
+            size_t new_shift = shift_;
+            if (new_shift > bits && new_root != nullptr
+                && static_cast<const branch*>(new_root.get())->children[1] == nullptr) {
+                // 根只剩一个子节点，树降低一层
+                node_ptr child = static_cast<const branch*>(new_root.get())->children[0];
+                new_root = std::move(child);
+                new_shift -= bits;
+            }
+            root_ = std::move(new_root);
+            shift_ = new_shift;
+            tail_ = std::move(new_tail);
+            size_--;
+        }
+
+        void clear() noexcept {
+            root_.reset();
+            tail_.reset();
+            size_ = 0;
+            shift_ = bits;
+        }
+
+        void swap(persistent_vector& other) noexcept {
+            root_.swap(other.root_);
+            tail_.swap(other.tail_);
+            MySTL::swap(size_, other.size_);
+            MySTL::swap(shift_, other.shift_);
+        }
+
+    private:
+        node_ptr root_;   // 第 shift_ 层的内部节点，树为空时为空指针
+        leaf_ptr tail_;   // 最后 1~32 个元素，不在树中
+        size_t size_;
+        size_t shift_;    // 根节点对应的位移量，叶子的父节点为 bits
+
+        // 树中元素的个数，也就是尾部第一个元素的下标
+        size_t tail_offset() const noexcept {
+            return size_ < width ? 0 : ((size_ - 1) >> bits) << bits;
+        }
+
+        const T* leaf_for(size_t index) const {
+            if (index >= tail_offset()) {
+                return tail_->data();
+            }
+            const node* n = root_.get();
+            for (size_t level = shift_; level > 0; level -= bits) {
+                n = static_cast<const branch*>(n)->children[(index >> level) & mask].get();
+            }
+            return static_cast<const leaf*>(n)->data();
+        }
+
+        leaf_ptr leaf_node_for(size_t index) const {
+            node_ptr n = root_;
+            for (size_t level = shift_; level > 0; level -= bits) {
+                n = static_cast<const branch*>(n.get())->children[(index >> level) & mask];
+            }
+            return std::static_pointer_cast<const leaf>(n);
+        }
+
+        static std::shared_ptr<leaf> copy_leaf(const leaf* src) {
+            return src != nullptr ? std::make_shared<leaf>(*src) : std::make_shared<leaf>();
+        }
+
+        static std::shared_ptr<branch> copy_branch(const branch* src) {
+            return src != nullptr ? std::make_shared<branch>(*src) : std::make_shared<branch>();
+        }
+
+        // 从第 level 层一路向下只有最左侧分支的新路径，末端挂上 n
+        static node_ptr new_path(size_t level, node_ptr n) {
+            if (level == 0) {
+                return n;
+            }
+            std::shared_ptr<branch> b = std::make_shared<branch>();
+            b->children[0] = new_path(level - bits, std::move(n));
+            return b;
+        }
+
+        // 把已满的尾部作为树中最后一个叶子挂入，返回复制后的 parent
+        node_ptr push_tail(size_t level, const branch* parent, const leaf_ptr& tail) const {
+            std::shared_ptr<branch> result = copy_branch(parent);
+            size_t sub = ((size_ - 1) >> level) & mask;
+            if (level == bits) {
+                result->children[sub] = tail;
+            }
+            else {
+                const node* child = parent != nullptr ? parent->children[sub].get() : nullptr;
+                result->children[sub] = child != nullptr
+                        ? push_tail(level - bits, static_cast<const branch*>(child), tail)
+                        : new_path(level - bits, tail);
+            }
+            return result;
+        }
+
+        // 去掉树中最后一个叶子，子树因此变空时返回空指针
+        node_ptr pop_tail(size_t level, const branch* n) const {
+            size_t sub = ((size_ - 2) >> level) & mask;
+            if (level > bits) {
+                node_ptr child = pop_tail(level - bits, static_cast<const branch*>(n->children[sub].get()));
+                if (child == nullptr && sub == 0) {
+                    return node_ptr();
+                }
+                std::shared_ptr<branch> result = copy_branch(n);
+                result->children[sub] = std::move(child);
+                return result;
+            }
+            if (sub == 0) {
+                return node_ptr();
+            }
+            std::shared_ptr<branch> result = copy_branch(n);
+            result->children[sub].reset();
+            return result;
+        }
+
+        static node_ptr assoc(size_t level, const node* n, size_t index, const T& value) {
+            if (level == 0) {
+                std::shared_ptr<leaf> result = copy_leaf(static_cast<const leaf*>(n));
+                result->data()[index & mask] = value;
+                return result;
+            }
+            const branch* b = static_cast<const branch*>(n);
+            size_t sub = (index >> level) & mask;
+            std::shared_ptr<branch> result = copy_branch(b);
+            result->children[sub] = assoc(level - bits, b->children[sub].get(), index, value);
+            return result;
+        }
+    };
+}
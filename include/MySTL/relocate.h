@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <cstring> // 引入memcpy、memmove
+#include <memory>  // 引入allocator_traits
+#include <type_traits>
+#include <utility> // 引入forward、move
+#include "type_traits.h"
+
+namespace MySTL {
+
+    // 连续存储容器（vector、small_vector）共用的元素搬运
+    // 编译期按 is_trivially_relocatable 分派：可平凡重定位时整块 memcpy/memmove，否则逐个移动
+    // true_type 版本直接搬字节，跳过分配器的 construct/destroy，
+    // 因此要求分配器不依赖自定义 construct（标准库对可平凡重定位的处理也是如此）
+    namespace detail {
+
+        template<typename T>
+        using relocatable_t = std::integral_constant<bool, MySTL::is_trivially_relocatable<T>::value>;
+
+        // 把 [src, src + n) 搬到未初始化的 dst，结束后 src 处不再有存活对象
+        template<typename Alloc, typename T>
+        void relocate(Alloc&, T* dst, T* src, size_t n, std::true_type) noexcept {
+            if (n > 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        }
+
+        template<typename Alloc, typename T>
+        void relocate(Alloc& alloc, T* dst, T* src, size_t n, std::false_type) {
+            using alloc_traits = std::allocator_traits<Alloc>;
+            for (size_t i = 0; i < n; i++) {
+                // 在新内存上移动构造对象，避免拷贝
+                alloc_traits::construct(alloc, &dst[i], std::move(src[i]));
+            }
+            // 销毁旧内存中的对象
+            for (size_t i = 0; i < n; i++) {
+                alloc_traits::destroy(alloc, &src[i]);
+            }
+        }
+
+        template<typename Alloc, typename T>
+        void relocate(Alloc& alloc, T* dst, T* src, size_t n) noexcept(relocatable_t<T>::value) {
+            relocate(alloc, dst, src, n, relocatable_t<T>());
+        }
+
+        // 在 data[index] 处插入 value，成功后 size 加一；调用前需保证 size 小于容量
+        // value 可能引用本数组中的元素（如 v.insert(v.begin(), v[1])），
+        // 所以先把新元素构造到局部，再挪动尾部，挪动不会改变要插入的值
+        template<typename Alloc, typename T, typename U>
+        void insert_one(Alloc& alloc, T* data, size_t& size, size_t index, U&& value, std::true_type) {
+            using alloc_traits = std::allocator_traits<Alloc>;
+            // 可平凡重定位：局部构造好后按字节搬进去即可，局部对象随之结束生命周期
+            alignas(T) unsigned char buf[sizeof(T)];
+            T* tmp = reinterpret_cast<T*>(buf);
+            alloc_traits::construct(alloc, tmp, std::forward<U>(value));
+            size_t tail = size - index;
+            // 整体把尾部后移一格，腾出 index 处的未初始化空间
+            if (tail > 0) {
+                std::memmove(static_cast<void*>(data + index + 1), static_cast<const void*>(data + index),
+                        tail * sizeof(T));
+            }
+            std::memcpy(static_cast<void*>(data + index), static_cast<const void*>(tmp), sizeof(T));
+            size++;
+        }
+
+        template<typename Alloc, typename T, typename U>
+        void insert_one(Alloc& alloc, T* data, size_t& size, size_t index, U&& value, std::false_type) {
+            using alloc_traits = std::allocator_traits<Alloc>;
+            T tmp(std::forward<U>(value));
+            if (index < size) {
+                alloc_traits::construct(alloc, &data[size], std::move(data[size - 1]));
+                size++; // 末尾新构造的元素立即计入，后面的赋值抛异常时也能被正常析构
+                for (size_t i = size - 2; i > index; i--) {
+                    data[i] = std::move(data[i - 1]);
+                }
+                data[index] = std::move(tmp);
+            }
+            else {
+                alloc_traits::construct(alloc, &data[size], std::move(tmp));
+                size++;
+            }
+        }
+
+        template<typename Alloc, typename T, typename U>
+        void insert_one(Alloc& alloc, T* data, size_t& size, size_t index, U&& value) {
+            insert_one(alloc, data, size, index, std::forward<U>(value), relocatable_t<T>());
+        }
+
+        // 擦除 data 中的 [first, last)，size 相应减少；调用前需保证 first < last <= size
+        template<typename Alloc, typename T>
+        void erase_range(Alloc& alloc, T* data, size_t& size, size_t first, size_t last, std::true_type) noexcept {
+            using alloc_traits = std::allocator_traits<Alloc>;
+            for (size_t i = first; i < last; i++) {
+                alloc_traits::destroy(alloc, &data[i]);
+            }
+            // 尾部整体前移，被覆盖的位置已经析构过了
+            std::memmove(static_cast<void*>(data + first), static_cast<const void*>(data + last),
+                    (size - last) * sizeof(T));
+            size -= last - first;
+        }
+
+        template<typename Alloc, typename T>
+        void erase_range(Alloc& alloc, T* data, size_t& size, size_t first, size_t last, std::false_type) {
+            using alloc_traits = std::allocator_traits<Alloc>;
+            size_t count = last - first;
+            for (size_t i = last; i < size; i++) {
+                data[i - count] = std::move(data[i]);
+            }
+            // 一次性销毁末尾 count 个剩余元素
+            for (size_t i = size - count; i < size; i++) {
+                alloc_traits::destroy(alloc, &data[i]);
+            }
+            size -= count;
+        }
+
+        template<typename Alloc, typename T>
+        void erase_range(Alloc& alloc, T* data, size_t& size, size_t first, size_t last)
+                noexcept(relocatable_t<T>::value) {
+            erase_range(alloc, data, size, first, last, relocatable_t<T>());
+        }
+    }
+}
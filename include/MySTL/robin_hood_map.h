@@ -0,0 +1,531 @@
+#pragma once
+
+#include <cstddef>    // 引入size_t
+#include <cstdint>    // 引入uint32_t
+#include <cstring>    // 引入memset
+#include <functional> // 引入hash、equal_to
+#include <memory>     // 引入allocator_traits
+#include <new>
+#include <stdexcept>  // 引入length_error
+#include <utility>    // 引入forward、move、pair
+#include "algorithm.h"
+#include "allocator.h"
+#include "hash.h"
+
+namespace MySTL {
+
+    // Robin Hood 开放寻址哈希表，接口与 unordered_map 基本一致
+    //   1. 每个槽记录元素到其理想位置的探测距离；插入时遇到距离比自己短的"富"元素就把位置抢过来，
+    //      让它继续向后找，所有元素的探测距离因此趋于平均，最坏情况远好于普通线性探测
+    //   2. 查找未命中时，一旦当前槽的距离小于已走的步数即可停止（键若存在早该出现），未命中和命中一样快
+    //   3. 删除采用后移（backward shift）：把后面不在理想位置的元素逐个前移一格，不留墓碑，
+    //      频繁删除后查找也不会变慢
+    //   4. 最大负载 0.9；插入时探测距离超过 max_probe_length 也会提前扩容，尾延迟有界
+    //      （负载低于 1/8 时不因探测距离扩容，哈希函数很差时退化为线性探测，而不是无限扩容）
+    // 插入、删除都会移动其他元素，使所有迭代器和元素引用失效
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class robin_hood_map {
+    public:
+        // 槽中保存的键值对，成员名与 unordered_map 的节点相同
+        struct slot_type {
+            Key key;
+            T value;
+
+            template<typename K, typename... Args>
+            slot_type(K&& k, Args&&... args) : key(std::forward<K>(k)), value(std::forward<Args>(args)...) {}
+
+            slot_type(slot_type&&) = default;
+            slot_type& operator=(slot_type&&) = default;
+        };
+
+    private:
+        // 0 表示空槽，d + 1 表示距理想位置 d 步
+        // 探测距离不会超过容量，容量上限保证 d + 1 总能表示，哈希再差也不会截断
+        using dist_type = uint32_t;
+        using slot_allocator = MySTL::allocator<slot_type>;
+        using dist_allocator = MySTL::allocator<dist_type>;
+        using slot_traits = std::allocator_traits<slot_allocator>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = slot_type;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        // 插入时探测距离超过该值就提前扩容（负载过低时除外，避免哈希函数很差时无限扩容）
+        static constexpr size_t max_probe_length = 64;
+
+        // 容量上限，超过时抛 length_error
+        static constexpr size_t max_capacity = size_t(1) << 31;
+
+        // ================== 迭代器实现 ==================
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+            friend class robin_hood_map;
+
+            iterator(robin_hood_map* map, size_t index) : iterator(map, index, map->capacity_) {}
+
+            slot_type& operator*() const { return map_->slots_[index_]; }
+            slot_type* operator->() const { return &map_->slots_[index_]; }
+
+            iterator& operator++() {
+                index_ = map_->next_full(index_ + 1, limit_);
+                return *this;
+            }
+
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+        private:
+            robin_hood_map* map_;
+            size_t index_;
+            // 遍历到该下标即结束，见 erase(iterator)
+            size_t limit_;
+
+            iterator(robin_hood_map* map, size_t index, size_t limit) : map_(map), index_(index), limit_(limit) {}
+        };
+
+        class const_iterator {
+        public:
+            const_iterator(const robin_hood_map* map, size_t index)
+                : map_(map), index_(index), limit_(map->capacity_) {}
+
+            const_iterator(const iterator& other) : map_(other.map_), index_(other.index_), limit_(other.limit_) {}
+
+            const slot_type& operator*() const { return map_->slots_[index_]; }
+            const slot_type* operator->() const { return &map_->slots_[index_]; }
+
+            const_iterator& operator++() {
+                index_ = map_->next_full(index_ + 1, limit_);
+                return *this;
+            }
+
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+        private:
+            const robin_hood_map* map_;
+            size_t index_;
+            size_t limit_;
+        };
+
+        // 空表不分配内存，第一次插入时才分配
+        robin_hood_map() noexcept
+            : dist_(nullptr), slots_(nullptr), capacity_(0), size_(0), grow_on_next_insert_(false),
+              hash_func_(), key_eq_() {}
+
+        explicit robin_hood_map(size_t n) : robin_hood_map() {
+            reserve(n);
+        }
+
+        ~robin_hood_map() {
+            destroy_all();
+            release(dist_, slots_, capacity_);
+        }
+
+        // ================== 五法则实现 ==================
+
+        robin_hood_map(const robin_hood_map& other)
+            : dist_(nullptr), slots_(nullptr), capacity_(0), size_(0), grow_on_next_insert_(false),
+              hash_func_(other.hash_func_), key_eq_(other.key_eq_)
+        {
+            reserve(other.size_);
+            for (size_t i = 0; i < other.capacity_; i++) {
+                if (other.dist_[i] != 0) {
+                    const slot_type& slot = other.slots_[i];
+                    insert_unique(hash_of(slot.key), slot.key, slot.value);
+                }
+            }
+        }
+
+        // 拷贝-交换：新表构造成功后才替换，异常时原表不变
+        robin_hood_map& operator=(const robin_hood_map& other) {
+            if (this != &other) {
+                robin_hood_map tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        robin_hood_map(robin_hood_map&& other) noexcept
+            : dist_(other.dist_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+              grow_on_next_insert_(other.grow_on_next_insert_), hash_func_(std::move(other.hash_func_)),
+              key_eq_(std::move(other.key_eq_))
+        {
+            other.reset_state();
+        }
+
+        robin_hood_map& operator=(robin_hood_map&& other) noexcept {
+            if (this != &other) {
+                destroy_all();
+                release(dist_, slots_, capacity_);
+                dist_ = other.dist_;
+                slots_ = other.slots_;
+                capacity_ = other.capacity_;
+                size_ = other.size_;
+                grow_on_next_insert_ = other.grow_on_next_insert_;
+                hash_func_ = std::move(other.hash_func_);
+                key_eq_ = std::move(other.key_eq_);
+                other.reset_state();
+            }
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() { return iterator(this, next_full(0, capacity_)); }
+        iterator end() { return iterator(this, capacity_); }
+        const_iterator begin() const { return const_iterator(this, next_full(0, capacity_)); }
+        const_iterator end() const { return const_iterator(this, capacity_); }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return capacity_; }
+
+        float load_factor() const noexcept {
+            return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+        }
+
+        // ================== 查找 ==================
+        iterator find(const Key& key) {
+            return iterator(this, find_index(key));
+        }
+
+        const_iterator find(const Key& key) const {
+            return const_iterator(this, find_index(key));
+        }
+
+        size_t count(const Key& key) const {
+            return find_index(key) != capacity_ ? 1 : 0;
+        }
+
+        // ================== 插入 ==================
+        // 已存在时不覆盖，返回 false
+        bool insert(const Key& key, const T& value) {
+            return emplace(key, value);
+        }
+
+        // 第一个参数是键，其余参数用于构造值
+        template<typename K, typename... Args>
+        bool emplace(K&& key, Args&&... args) {
+            return try_emplace_impl(std::forward<K>(key), std::forward<Args>(args)...).second;
+        }
+
+        // 下标访问，如果不存在则默认初始化
+        // 插入可能重新散列，必须先拿到下标再读 slots_
+        T& operator[](const Key& key) {
+            size_t index = try_emplace_impl(key).first;
+            return slots_[index].value;
+        }
+
+        T& operator[](Key&& key) {
+            size_t index = try_emplace_impl(std::move(key)).first;
+            return slots_[index].value;
+        }
+
+        // ================== 删除 ==================
+        bool erase(const Key& key) {
+            size_t index = find_index(key);
+            if (index == capacity_) {
+                return false;
+            }
+            erase_at(index);
+            return true;
+        }
+
+        // 后移删除会把后面的元素挪到 pos 处，因此返回的迭代器仍从 pos 开始检查
+        // 后移链跨过表尾时，下标 0 处（已遍历过）的元素会被挪到表尾；
+        // 迭代器的 limit_ 随之前移一格，边删边遍历时不会再次访问这些元素
+        iterator erase(iterator pos) {
+            size_t limit = pos.limit_;
+            size_t moved = erase_at(pos.index_);
+            if (limit - pos.index_ <= moved) {
+                limit--;
+            }
+            return iterator(this, next_full(pos.index_, limit), limit);
+        }
+
+        void clear() noexcept {
+            destroy_all();
+            if (capacity_ > 0) {
+                std::memset(dist_, 0, capacity_ * sizeof(dist_type));
+            }
+            size_ = 0;
+            grow_on_next_insert_ = false;
+        }
+
+        // 保证容纳 n 个元素之前不会因负载而重新散列
+        void reserve(size_t n) {
+            if (n == 0) {
+                return;
+            }
+            size_t cap = min_capacity;
+            while (max_load(cap) < n && cap <= max_capacity) {
+                cap *= 2;
+            }
+            if (cap > capacity_) {
+                rehash_to(cap);
+            }
+        }
+
+        void swap(robin_hood_map& other) noexcept {
+            MySTL::swap(dist_, other.dist_);
+            MySTL::swap(slots_, other.slots_);
+            MySTL::swap(capacity_, other.capacity_);
+            MySTL::swap(size_, other.size_);
+            MySTL::swap(grow_on_next_insert_, other.grow_on_next_insert_);
+            MySTL::swap(hash_func_, other.hash_func_);
+            MySTL::swap(key_eq_, other.key_eq_);
+        }
+
+    private:
+        static constexpr size_t min_capacity = 16;
+
+        dist_type* dist_;      // 每个槽的探测距离 + 1，0 为空槽
+        slot_type* slots_;     // 只有 dist_ 非 0 的槽中有对象
+        size_t capacity_;      // 0 或不小于 16 的 2 的幂
+        size_t size_;
+        bool grow_on_next_insert_; // 后移过程中有元素的探测距离超限，下一次插入前扩容
+        Hash hash_func_;
+        KeyEqual key_eq_;
+
+        // 最大负载 0.9
+        static size_t max_load(size_t cap) noexcept { return cap - (cap + 9) / 10; }
+
+        void reset_state() noexcept {
+            dist_ = nullptr;
+            slots_ = nullptr;
+            capacity_ = 0;
+            size_ = 0;
+            grow_on_next_insert_ = false;
+        }
+
+        size_t hash_of(const Key& key) const {
+            return MySTL::hash_mix(hash_func_(key));
+        }
+
+        // 返回 [index, limit) 中第一个非空槽，没有时返回 capacity_（即 end）
+        size_t next_full(size_t index, size_t limit) const noexcept {
+            while (index < limit && dist_[index] == 0) {
+                index++;
+            }
+            return index < limit ? index : capacity_;
+        }
+
+        // 负载太低时即使探测很长也不扩容，否则哈希函数很差时会无限扩容
+        bool probe_too_long(size_t d) const noexcept {
+            return d > max_probe_length && size_ >= capacity_ / 8;
+        }
+
+        // 找不到时返回 capacity_
+        size_t find_index(const Key& key) const {
+            if (size_ == 0) {
+                return capacity_;
+            }
+            size_t mask = capacity_ - 1;
+            size_t index = hash_of(key) & mask;
+            for (size_t d = 1;; d++) {
+                // 空槽，或者遇到比自己离家更近的元素：按 Robin Hood 的规则键若存在一定排在它前面
+                if (dist_[index] < d) {
+                    return capacity_;
+                }
+                if (dist_[index] == d && key_eq_(slots_[index].key, key)) {
+                    return index;
+                }
+                index = (index + 1) & mask;
+            }
+        }
+
+        // 返回 (槽下标, 是否新插入)
+        template<typename K, typename... Args>
+        std::pair<size_t, bool> try_emplace_impl(K&& key, Args&&... args) {
+            size_t index = find_index(key);
+            if (index != capacity_) {
+                return std::pair<size_t, bool>(index, false);
+            }
+            if (capacity_ == 0 || size_ + 1 > max_load(capacity_) || grow_on_next_insert_) {
+                rehash_to(capacity_ == 0 ? min_capacity : capacity_ * 2);
+            }
+            size_t hash = hash_of(key);
+            size_t d;
+            index = find_insert_slot(hash, d);
+            while (probe_too_long(d)) {
+                rehash_to(capacity_ * 2);
+                index = find_insert_slot(hash, d);
+            }
+            place(index, d, std::forward<K>(key), std::forward<Args>(args)...);
+            return std::pair<size_t, bool>(index, true);
+        }
+
+        // 新元素应放的位置：第一个空槽或比新元素"富"的元素，d 返回探测距离 + 1
+        size_t find_insert_slot(size_t hash, size_t& d) const noexcept {
+            size_t mask = capacity_ - 1;
+            size_t index = hash & mask;
+            d = 1;
+            while (dist_[index] >= d) {
+                index = (index + 1) & mask;
+                d++;
+            }
+            return index;
+        }
+
+        // 插入一个确定不存在的键，不扩容；调用前保证还有空槽
+        // 拷贝构造和重新散列使用，探测过长只记下标志，留到下一次插入时扩容
+        template<typename... Args>
+        void insert_unique(size_t hash, Args&&... args) {
+            size_t d;
+            size_t index = find_insert_slot(hash, d);
+            if (probe_too_long(d)) {
+                grow_on_next_insert_ = true;
+            }
+            place(index, d, std::forward<Args>(args)...);
+        }
+
+        // 在 find_insert_slot 找到的位置构造新元素，原住户及其后的元素依次后移
+        template<typename... Args>
+        void place(size_t index, size_t d, Args&&... args) {
+            size_t mask = capacity_ - 1;
+            slot_allocator alloc;
+            if (dist_[index] == 0) {
+                slot_traits::construct(alloc, slots_ + index, std::forward<Args>(args)...);
+                dist_[index] = static_cast<dist_type>(d);
+                size_++;
+                return;
+            }
+
+            // 先把原住户搬出来，在它的位置构造新元素，再让原住户继续向后找位置
+            slot_type carry(std::move(slots_[index]));
+            size_t carry_dist = dist_[index];
+            slot_traits::destroy(alloc, slots_ + index);
+            try {
+                slot_traits::construct(alloc, slots_ + index, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                slot_traits::construct(alloc, slots_ + index, std::move(carry));
+                throw;
+            }
+            dist_[index] = static_cast<dist_type>(d);
+            size_++;
+
+            index = (index + 1) & mask;
+            carry_dist++;
+            while (dist_[index] != 0) {
+                if (dist_[index] < carry_dist) {
+                    MySTL::swap(carry, slots_[index]);
+                    size_t tmp = dist_[index];
+                    dist_[index] = static_cast<dist_type>(carry_dist);
+                    carry_dist = tmp;
+                }
+                index = (index + 1) & mask;
+                carry_dist++;
+                if (probe_too_long(carry_dist)) {
+                    grow_on_next_insert_ = true;
+                }
+            }
+            slot_traits::construct(alloc, slots_ + index, std::move(carry));
+            dist_[index] = static_cast<dist_type>(carry_dist);
+        }
+
+        // 后移删除：后面离家不为 0 的元素依次前移一格，直到遇到空槽或已在理想位置的元素
+        // 返回前移的元素个数
+        size_t erase_at(size_t index) {
+            slot_allocator alloc;
+            size_t mask = capacity_ - 1;
+            size_t moved = 0;
+            slot_traits::destroy(alloc, slots_ + index);
+            size_t next = (index + 1) & mask;
+            while (dist_[next] > 1) {
+                slot_traits::construct(alloc, slots_ + index, std::move(slots_[next]));
+                slot_traits::destroy(alloc, slots_ + next);
+                dist_[index] = static_cast<dist_type>(dist_[next] - 1);
+                index = next;
+                next = (next + 1) & mask;
+                moved++;
+            }
+            dist_[index] = 0;
+            size_--;
+            return moved;
+        }
+
+        void destroy_all() noexcept {
+            slot_allocator alloc;
+            for (size_t i = 0; i < capacity_; i++) {
+                if (dist_[i] != 0) {
+                    slot_traits::destroy(alloc, slots_ + i);
+                }
+            }
+        }
+
+        static void release(dist_type* dist, slot_type* slots, size_t cap) noexcept {
+            if (cap == 0) {
+                return;
+            }
+            dist_allocator dist_alloc;
+            slot_allocator slot_alloc;
+            dist_alloc.deallocate(dist, cap);
+            slot_alloc.deallocate(slots, cap);
+        }
+
+        // 分配新表并重新插入所有元素
+        // 元素的移动构造可能抛异常时改用拷贝，失败后原表保持不变
+        void rehash_to(size_t new_cap) {
+            if (new_cap > max_capacity) {
+                throw std::length_error("robin_hood_map too large");
+            }
+            dist_allocator dist_alloc;
+            slot_allocator slot_alloc;
+            dist_type* new_dist = dist_alloc.allocate(new_cap);
+            slot_type* new_slots;
+            try {
+                new_slots = slot_alloc.allocate(new_cap);
+            }
+            catch (...) {
+                dist_alloc.deallocate(new_dist, new_cap);
+                throw;
+            }
+            std::memset(new_dist, 0, new_cap * sizeof(dist_type));
+
+            dist_type* old_dist = dist_;
+            slot_type* old_slots = slots_;
+            size_t old_cap = capacity_;
+            size_t old_size = size_;
+
+            dist_ = new_dist;
+            slots_ = new_slots;
+            capacity_ = new_cap;
+            size_ = 0;
+            grow_on_next_insert_ = false;
+            try {
+                for (size_t i = 0; i < old_cap; i++) {
+                    if (old_dist[i] != 0) {
+                        slot_type& slot = old_slots[i];
+                        insert_unique(hash_of(slot.key), std::move_if_noexcept(slot.key),
+                                      std::move_if_noexcept(slot.value));
+                    }
+                }
+            }
+            catch (...) {
+                destroy_all();
+                release(dist_, slots_, capacity_);
+                dist_ = old_dist;
+                slots_ = old_slots;
+                capacity_ = old_cap;
+                size_ = old_size;
+                throw;
+            }
+            for (size_t i = 0; i < old_cap; i++) {
+                if (old_dist[i] != 0) {
+                    slot_traits::destroy(slot_alloc, old_slots + i);
+                }
+            }
+            release(old_dist, old_slots, old_cap);
+        }
+    };
+}
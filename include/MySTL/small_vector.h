@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <memory>  // 引入allocator_traits
+#include <stdexcept>
+#include <utility> // 引入forward、move
+#include "allocator.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "type_traits.h"
+#include "vector.h"
+
+namespace MySTL {
+
+    // 前 N 个元素直接存放在对象内部（通常就在栈上），超出后才溢出到堆
+    // 接口与 MySTL::vector 保持一致，迭代器直接复用 vector 的迭代器
+    // 代价：移动构造/移动赋值在内联状态下需要逐个搬运元素，不再是 O(1)，也不再 noexcept（T 的移动可能抛异常）
+    // Growth: 溢出到堆之后的增长策略，与 vector 相同，见 growth_policy.h
+    template<typename T, size_t N, typename Alloc = MySTL::allocator<T>, typename Growth = MySTL::grow_double>
+    class small_vector {
+        static_assert(N > 0, "small_vector needs at least one inline slot");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+        using allocator_type = Alloc;
+
+        using iterator = typename MySTL::vector<T, Alloc>::iterator;
+        using const_iterator = typename MySTL::vector<T, Alloc>::const_iterator;
+
+        small_vector() noexcept : data_(inline_data()), capacity_(N), size_(0), alloc_() {}
+
+        explicit small_vector(const Alloc& alloc) noexcept
+            : data_(inline_data()), capacity_(N), size_(0), alloc_(alloc) {}
+
+        small_vector(size_t n, const value_type& value = value_type(), const Alloc& alloc = Alloc())
+            : data_(inline_data()), capacity_(N), size_(0), alloc_(alloc)
+        {
+            reserve(n);
+            for (size_t i = 0; i < n; i++) {
+                alloc_traits::construct(alloc_, &data_[i], value);
+                size_++;
+            }
+        }
+
+        ~small_vector() {
+            clear();
+            release();
+        }
+
+        // ================== 五法则实现 ==================
+
+        small_vector(const small_vector& other)
+            : data_(inline_data()), capacity_(N), size_(0),
+              alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; i++) {
+                alloc_traits::construct(alloc_, &data_[i], other.data_[i]);
+                size_++;
+            }
+        }
+
+        small_vector& operator=(const small_vector& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; i++) {
+                alloc_traits::construct(alloc_, &data_[i], other.data_[i]);
+                size_++;
+            }
+            return *this;
+        }
+
+        small_vector(small_vector&& other) noexcept(MySTL::is_trivially_relocatable<T>::value)
+            : data_(inline_data()), capacity_(N), size_(0), alloc_(std::move(other.alloc_))
+        {
+            steal(other);
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(MySTL::is_trivially_relocatable<T>::value) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            release();
+            data_ = inline_data();
+            capacity_ = N;
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(data_); }
+        iterator end() noexcept { return iterator(data_ + size_); }
+        const_iterator begin() const noexcept { return const_iterator(data_); }
+        const_iterator end() const noexcept { return const_iterator(data_ + size_); }
+        const_iterator cbegin() const noexcept { return const_iterator(data_); }
+        const_iterator cend() const noexcept { return const_iterator(data_ + size_); }
+
+        allocator_type get_allocator() const noexcept { return alloc_; }
+
+        // 指向连续存储的首元素，对齐程度由分配器决定（见 aligned_allocator）
+        pointer data() noexcept { return data_; }
+        const_pointer data() const noexcept { return data_; }
+
+        size_t size() const noexcept { return size_; }
+        size_t capacity() const noexcept { return capacity_; }
+        bool empty() const noexcept { return size_ == 0; }
+        // 元素当前是否仍存放在内联缓冲区中
+        bool is_inline() const noexcept { return data_ == inline_data(); }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity <= capacity_) {
+                return;
+            }
+            pointer new_data = alloc_traits::allocate(alloc_, new_capacity);
+            detail::relocate(alloc_, new_data, data_, size_);
+            release();
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        void push_back(const_reference value) {
+            if (size_ == capacity_) {
+                reserve(recommend(size_ + 1));
+            }
+            alloc_traits::construct(alloc_, &data_[size_], value);
+            size_++;
+        }
+
+        void push_back(value_type&& value) {
+            if (size_ == capacity_) {
+                reserve(recommend(size_ + 1));
+            }
+            alloc_traits::construct(alloc_, &data_[size_], std::move(value));
+            size_++;
+        }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            if (size_ == capacity_) {
+                reserve(recommend(size_ + 1));
+            }
+            alloc_traits::construct(alloc_, &data_[size_], std::forward<Args>(args)...);
+            size_++;
+        }
+
+        iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            difference_type index_first = first - cbegin();
+            difference_type index_last = last - cbegin();
+            if (index_last > index_first) {
+                detail::erase_range(alloc_, data_, size_, index_first, index_last);
+            }
+            return iterator(data_ + index_first);
+        }
+
+        iterator insert(const_iterator pos, const_reference value) {
+            difference_type index = pos - cbegin();
+            if (size_ == capacity_) {
+                // value 可能引用本数组中的元素，扩容会释放旧内存，先把它取到局部
+                value_type tmp(value);
+                reserve(recommend(size_ + 1));
+                detail::insert_one(alloc_, data_, size_, index, std::move(tmp));
+            }
+            else {
+                detail::insert_one(alloc_, data_, size_, index, value);
+            }
+            return iterator(data_ + index);
+        }
+
+        iterator insert(const_iterator pos, T&& value) {
+            difference_type index = pos - cbegin();
+            if (size_ == capacity_) {
+                // value 可能引用本数组中的元素，扩容会释放旧内存，先把它取到局部
+                value_type tmp(std::move(value));
+                reserve(recommend(size_ + 1));
+                detail::insert_one(alloc_, data_, size_, index, std::move(tmp));
+            }
+            else {
+                detail::insert_one(alloc_, data_, size_, index, std::move(value));
+            }
+            return iterator(data_ + index);
+        }
+
+        void pop_back() {
+            if (size_ > 0) {
+                size_--;
+                alloc_traits::destroy(alloc_, &data_[size_]);
+            }
+        }
+
+        void clear() noexcept {
+            for (size_t i = 0; i < size_; ++i) {
+                alloc_traits::destroy(alloc_, &data_[i]);
+            }
+            size_ = 0;
+        }
+
+        reference at(size_t index) {
+            if (index >= size_) {
+                throw std::out_of_range("small_vector::at: index out of range");
+            }
+            return data_[index];
+        }
+
+        const_reference at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("small_vector::at: index out of range");
+            }
+            return data_[index];
+        }
+
+        void resize(size_t new_size) {
+            while (size_ > new_size) {
+                pop_back();
+            }
+            if (new_size > size_) {
+                if (new_size > capacity_) {
+                    reserve(recommend(new_size));
+                }
+                for (size_t i = size_; i < new_size; ++i) {
+                    alloc_traits::construct(alloc_, &data_[i]);
+                    size_++;
+                }
+            }
+        }
+
+        value_type& operator[](size_t index) {
+            return data_[index];
+        }
+
+        const value_type& operator[](size_t index) const {
+            return data_[index];
+        }
+
+        // 内联状态下无法交换指针，只能借助一个临时对象走三次移动
+        void swap(small_vector& other) {
+            small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        pointer data_;
+        size_t capacity_;
+        size_t size_;
+        Alloc alloc_;
+        // 内联缓冲区，只提供原始内存，元素由 placement 构造
+        alignas(T) unsigned char inline_[N * sizeof(T)];
+
+        pointer inline_data() noexcept { return reinterpret_cast<pointer>(inline_); }
+        const_pointer inline_data() const noexcept { return reinterpret_cast<const_pointer>(inline_); }
+
+        // 释放堆上的缓冲区（内联缓冲区无需释放）
+        void release() noexcept {
+            if (!is_inline()) {
+                alloc_traits::deallocate(alloc_, data_, capacity_);
+            }
+        }
+
+        // 接管 other 的元素，调用前 *this 必须为空且处于内联状态
+        void steal(small_vector& other) {
+            if (other.is_inline()) {
+                // 内联的元素无法转移所有权，只能逐个搬过来
+                detail::relocate(alloc_, data_, other.data_, other.size_);
+            }
+            else {
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.capacity_ = N;
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+        // 由增长策略给出至少能容纳 required 个元素的新容量
+        size_t recommend(size_t required) const {
+            return Growth::next_capacity(capacity_, required, sizeof(value_type));
+        }
+    };
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <stdexcept>
+#include <tuple>
+#include <utility> // 引入forward、move、index_sequence
+#include "span.h"
+#include "vector.h"
+
+namespace MySTL {
+
+    // 结构体数组（SoA）：每个字段单独存放在一列连续内存中
+    // soa_vector<int, float, double> 相当于三个等长的 MySTL::vector，
+    // 只扫描某一列时不会把其他字段带进缓存，也便于编译器对单列做向量化
+    //
+    // 按行访问通过 row(i) 或迭代器得到 std::tuple<Ts&...>，例如：
+    //     for (auto row : v) { std::get<1>(row) += 1.0f; }
+    // 按列访问通过 column<I>() 得到 MySTL::span，可直接交给向量化循环
+    template<typename... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+        using columns_type = std::tuple<MySTL::vector<Ts>...>;
+        using indices = std::index_sequence_for<Ts...>;
+
+        // C++14 没有折叠表达式，借助数组初始化按顺序展开参数包
+        using swallow = int[];
+
+    public:
+        using value_type = std::tuple<Ts...>;
+        using reference = std::tuple<Ts&...>;
+        using const_reference = std::tuple<const Ts&...>;
+        using difference_type = std::ptrdiff_t;
+
+        template<size_t I>
+        using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+        // ================== 迭代器实现 ==================
+        // zip 迭代器：记录行号，解引用时把各列同一行的引用打包成 tuple
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+
+            iterator(soa_vector* vec, size_t index) : vec_(vec), index_(index) {}
+
+            reference operator*() const { return vec_->row(index_); }
+
+            iterator& operator++() { index_++; return *this; }
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            iterator& operator--() { index_--; return *this; }
+            iterator operator--(int) { iterator tmp = *this; --(*this); return tmp; }
+
+            iterator operator+(difference_type n) const { return iterator(vec_, index_ + n); }
+            iterator operator-(difference_type n) const { return iterator(vec_, index_ - n); }
+            difference_type operator-(const iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            bool operator<(const iterator& other) const { return index_ < other.index_; }
+            bool operator==(const iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+            size_t index() const { return index_; }
+
+        private:
+            soa_vector* vec_;
+            size_t index_;
+        };
+
+        class const_iterator {
+        public:
+            const_iterator(const soa_vector* vec, size_t index) : vec_(vec), index_(index) {}
+
+            const_iterator(const iterator& other) : vec_(other.vec_), index_(other.index_) {}
+
+            const_reference operator*() const { return vec_->row(index_); }
+
+            const_iterator& operator++() { index_++; return *this; }
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            const_iterator& operator--() { index_--; return *this; }
+            const_iterator operator--(int) { const_iterator tmp = *this; --(*this); return tmp; }
+
+            const_iterator operator+(difference_type n) const { return const_iterator(vec_, index_ + n); }
+            const_iterator operator-(difference_type n) const { return const_iterator(vec_, index_ - n); }
+            difference_type operator-(const const_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            bool operator<(const const_iterator& other) const { return index_ < other.index_; }
+            bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+            size_t index() const { return index_; }
+
+        private:
+            const soa_vector* vec_;
+            size_t index_;
+        };
+
+        soa_vector() noexcept : columns_(), size_(0) {}
+
+        // 拷贝由各列的 MySTL::vector 完成，使用编译器生成的版本即可
+        soa_vector(const soa_vector&) = default;
+        soa_vector& operator=(const soa_vector&) = default;
+
+        // 移动后需要把原对象的行数清零，不能用默认版本
+        soa_vector(soa_vector&& other) noexcept : columns_(std::move(other.columns_)), size_(other.size_) {
+            other.size_ = 0;
+        }
+
+        soa_vector& operator=(soa_vector&& other) noexcept {
+            if (this != &other) {
+                columns_ = std::move(other.columns_);
+                size_ = other.size_;
+                other.size_ = 0;
+            }
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size_); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        // 各列容量可能不同，取最小值
+        size_t capacity() const noexcept { return capacity_impl(indices()); }
+
+        // 第 I 列的连续视图，列内元素紧密排列
+        template<size_t I>
+        MySTL::span<column_type<I>> column() noexcept {
+            return MySTL::span<column_type<I>>(std::get<I>(columns_).data(), size_);
+        }
+
+        template<size_t I>
+        MySTL::span<const column_type<I>> column() const noexcept {
+            return MySTL::span<const column_type<I>>(std::get<I>(columns_).data(), size_);
+        }
+
+        reference row(size_t index) { return row_impl(index, indices()); }
+        const_reference row(size_t index) const { return row_impl(index, indices()); }
+
+        reference operator[](size_t index) { return row(index); }
+        const_reference operator[](size_t index) const { return row(index); }
+
+        reference at(size_t index) {
+            if (index >= size_) {
+                throw std::out_of_range("soa_vector::at: index out of range");
+            }
+            return row(index);
+        }
+
+        const_reference at(size_t index) const {
+            if (index >= size_) {
+                throw std::out_of_range("soa_vector::at: index out of range");
+            }
+            return row(index);
+        }
+
+        void reserve(size_t new_capacity) {
+            reserve_impl(new_capacity, indices());
+        }
+
+        void push_back(const Ts&... values) {
+            emplace_back(values...);
+        }
+
+        void push_back(Ts&&... values) {
+            emplace_back(std::move(values)...);
+        }
+
+        void push_back(const value_type& values) {
+            push_back_tuple(values, indices());
+        }
+
+        // 每列一个参数，第 i 个参数用于构造第 i 列的新元素
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back needs exactly one argument per column");
+            try {
+                emplace_back_impl(indices(), std::forward<Args>(args)...);
+            }
+            catch (...) {
+                // 只有前几列追加成功时，把它们回退，保持各列等长
+                truncate(size_, indices());
+                throw;
+            }
+            size_++;
+        }
+
+        void pop_back() {
+            if (size_ > 0) {
+                size_--;
+                truncate(size_, indices());
+            }
+        }
+
+        iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            size_t index_first = first.index();
+            size_t index_last = last.index();
+            if (index_last > index_first) {
+                erase_impl(index_first, index_last, indices());
+                size_ -= index_last - index_first;
+            }
+            return iterator(this, index_first);
+        }
+
+        void clear() noexcept {
+            truncate(0, indices());
+            size_ = 0;
+        }
+
+        void swap(soa_vector& other) noexcept {
+            swap_impl(other, indices());
+            MySTL::swap(size_, other.size_);
+        }
+
+    private:
+        columns_type columns_;
+        size_t size_;
+
+        template<size_t... Is>
+        reference row_impl(size_t index, std::index_sequence<Is...>) {
+            return reference(std::get<Is>(columns_)[index]...);
+        }
+
+        template<size_t... Is>
+        const_reference row_impl(size_t index, std::index_sequence<Is...>) const {
+            return const_reference(std::get<Is>(columns_)[index]...);
+        }
+
+        template<size_t... Is>
+        size_t capacity_impl(std::index_sequence<Is...>) const noexcept {
+            size_t caps[] = {std::get<Is>(columns_).capacity()...};
+            size_t cap = caps[0];
+            for (size_t c : caps) {
+                cap = c < cap ? c : cap;
+            }
+            return cap;
+        }
+
+        template<size_t... Is>
+        void reserve_impl(size_t new_capacity, std::index_sequence<Is...>) {
+            (void)swallow{0, (std::get<Is>(columns_).reserve(new_capacity), 0)...};
+        }
+
+        template<size_t... Is>
+        void swap_impl(soa_vector& other, std::index_sequence<Is...>) noexcept {
+            (void)swallow{0, (std::get<Is>(columns_).swap(std::get<Is>(other.columns_)), 0)...};
+        }
+
+        template<size_t... Is, typename... Args>
+        void emplace_back_impl(std::index_sequence<Is...>, Args&&... args) {
+            (void)swallow{0, (std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), 0)...};
+        }
+
+        template<size_t... Is>
+        void push_back_tuple(const value_type& values, std::index_sequence<Is...>) {
+            emplace_back(std::get<Is>(values)...);
+        }
+
+        template<size_t... Is>
+        void truncate(size_t n, std::index_sequence<Is...>) noexcept {
+            (void)swallow{0, (truncate_column(std::get<Is>(columns_), n), 0)...};
+        }
+
+        template<typename Column>
+        static void truncate_column(Column& column, size_t n) noexcept {
+            while (column.size() > n) {
+                column.pop_back();
+            }
+        }
+
+        template<size_t... Is>
+        void erase_impl(size_t first, size_t last, std::index_sequence<Is...>) {
+            (void)swallow{0, (erase_column(std::get<Is>(columns_), first, last), 0)...};
+        }
+
+        template<typename Column>
+        static void erase_column(Column& column, size_t first, size_t last) {
+            column.erase(column.cbegin() + first, column.cbegin() + last);
+        }
+    };
+}
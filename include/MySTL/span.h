@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+
+namespace MySTL {
+
+    // 一段连续内存的非拥有视图（C++14 没有 std::span）
+    // 只记录首地址和长度，拷贝开销与两个指针相同；底层容器扩容后视图失效
+    template<typename T>
+    class span {
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        span() noexcept : data_(nullptr), size_(0) {}
+        span(pointer data, size_t size) noexcept : data_(data), size_(size) {}
+
+        iterator begin() const noexcept { return data_; }
+        iterator end() const noexcept { return data_ + size_; }
+
+        pointer data() const noexcept { return data_; }
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        reference operator[](size_t index) const { return data_[index]; }
+
+    private:
+        pointer data_;
+        size_t size_;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <type_traits>
+
+namespace MySTL
+{
+    // "可平凡重定位"：把对象的字节原样搬到新地址，并且不在旧地址调用析构，
+    // 结果等价于"移动构造到新地址 + 析构旧对象"
+    // 满足该性质时，容器扩容、插入、删除可以直接用 memcpy / memmove 整块搬运
+    //
+    // 平凡可拷贝的类型天然满足。很多非平凡类型也满足（如不含自引用指针的
+    // unique_ptr、大多数 pimpl 类），可以通过特化来显式开启：
+    //     template<> struct MySTL::is_trivially_relocatable<Foo> : std::true_type {};
+    // 注意：内部保存了指向自身指针的类型（如 MySTL::list 的内嵌哨兵）绝不能开启
+    template<typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {
+    };
+} // namespace MySTL
@@ -2,6 +2,7 @@
 
 #include "vector.h"
 #include "list.h"
+#include "hash.h"
 
 #include <bits/c++config.h>
 #include <cstddef>
@@ -10,7 +11,9 @@
 
 namespace MySTL
 {
-    template<typename Key, typename T>
+    // BucketPolicy 决定哈希值到桶下标的映射，见 hash.h：
+    // 默认 mod_bucket_policy 取模；pow2_bucket_policy 用 2 的幂桶数加混合后掩码，省掉热路径上的除法
+    template<typename Key, typename T, typename BucketPolicy = MySTL::mod_bucket_policy>
     class unordered_map
     {
         struct Node
@@ -29,6 +32,11 @@ namespace MySTL
         // 元素数量找过负载因子的阈值 bucket_count * load_factor 后自动扩容
         float load_factor = 0.75f;
 
+        size_t bucket_index(const Key& key, size_t n) const
+        {
+            return BucketPolicy::index(hash_func(key), n);
+        }
+
     public:
         class iterator
         {
@@ -88,8 +96,8 @@ namespace MySTL
                 if (!buckets[i].empty()) {
                     return iterator(i, buckets[i].begin(), this);
                 }
-                return end(); // 类中的函数互相可见
             }
+            return end(); // 类中的函数互相可见
         }
         iterator end()
         {
@@ -98,7 +106,7 @@ namespace MySTL
 
         iterator find(const Key& key)
         {
-            size_t idx = hash_func(key) % bucket_count;
+            size_t idx = bucket_index(key, bucket_count);
             for (auto it = buckets[idx].begin(); it != buckets[idx].end();
                  it++) {
                 if (it->key == key) {
@@ -111,12 +119,13 @@ namespace MySTL
         // 扩容
         void rehash(size_t new_bucket_count)
         {
+            new_bucket_count = BucketPolicy::bucket_count_for(new_bucket_count);
             MySTL::vector<MySTL::list<Node>> new_buckets;
             new_buckets.resize(new_bucket_count);
             for (size_t i = 0; i < bucket_count; i++) {
                 for (auto& node : buckets[i]) {
                     // 重新计算扩容后的哈希值并获得下标
-                    size_t idx = hash_func(node.key) % new_bucket_count;
+                    size_t idx = bucket_index(node.key, new_bucket_count);
                     new_buckets[idx].push_back(node);
                 }
             }
@@ -132,7 +141,8 @@ namespace MySTL
         }
 
         // 默认构造
-        unordered_map(size_t n = 16): bucket_count(n), elem_count(0)
+        unordered_map(size_t n = 16)
+            : bucket_count(BucketPolicy::bucket_count_for(n)), elem_count(0)
         {
             buckets.resize(bucket_count);
         }
@@ -201,7 +211,7 @@ namespace MySTL
         bool insert(const Key& key, const T& value)
         {
             check_rehash();
-            size_t idx = hash_func(key) % bucket_count;
+            size_t idx = bucket_index(key, bucket_count);
             for (auto& node : buckets[idx]) {
                 if (node.key == key) {
                     return false; // 已存在
@@ -216,7 +226,7 @@ namespace MySTL
         T& operator[](const Key& key)
         {
             check_rehash();
-            size_t idx = hash_func(key) % bucket_count;
+            size_t idx = bucket_index(key, bucket_count);
             for (auto& node : buckets[idx]) {
                 if (node.key == key) {
                     return node.value;
@@ -230,7 +240,7 @@ namespace MySTL
 
         bool erase(const Key& key)
         {
-            size_t idx = hash_func(key) % bucket_count;
+            size_t idx = bucket_index(key, bucket_count);
             for (auto it = buckets[idx].begin(); it != buckets[idx].end();
                  it++) {
                 if (it->key == key) {
@@ -246,7 +256,7 @@ namespace MySTL
         bool emplace(Args&&... args)
         {
             Node node(std::forward<Args>(args)...);
-            size_t idx = hash_func(node.key) % bucket_count;
+            size_t idx = bucket_index(node.key, bucket_count);
             for (auto& n : buckets[idx]) {
                 if (n.key == node.key)
                     return false;
@@ -277,7 +287,7 @@ namespace MySTL
 
         size_t count(const Key& key) const
         {
-            size_t idx = hash_func(key) % bucket_count;
+            size_t idx = bucket_index(key, bucket_count);
             for (auto& node : buckets[idx]) {
                 if (node.key == key) {
                     return 1;
@@ -288,6 +298,7 @@ namespace MySTL
 
         void reserve(size_t new_bucket_count)
         {
+            new_bucket_count = BucketPolicy::bucket_count_for(new_bucket_count);
             if (new_bucket_count > bucket_count) {
                 rehash(new_bucket_count);
             }
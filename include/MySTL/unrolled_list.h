@@ -0,0 +1,468 @@
+#pragma once
+
+#include <cstddef> // 引入size_t
+#include <memory>  // 引入allocator_traits
+#include <new>
+#include <utility> // 引入forward、move
+#include "algorithm.h"
+#include "allocator.h"
+
+namespace MySTL {
+
+    namespace detail {
+        // 每个节点的元素区约 256 字节（4 条缓存行），至少 4 个元素
+        constexpr size_t unrolled_list_node_capacity(size_t elem_size) {
+            return elem_size * 4 < 256 ? 256 / elem_size : 4;
+        }
+    }
+
+    // 展开链表：每个节点存放最多 K 个连续元素的小数组
+    //   1. 顺序遍历时节点内是连续内存，每 K 个元素才追一次指针，缓存未命中减少到约 1/K
+    //   2. 在迭代器处插入：节点未满时节点内平移，已满时对半拆分，O(K)，与总长度无关
+    //   3. 删除：节点内平移，节点元素不足一半且能与后继放进一个节点时合并，空节点立即释放
+    // 迭代器是双向迭代器，接口与 list 相同；插入、删除会使同一节点（拆分、合并时还包括相邻节点）上的迭代器失效
+    template<typename T, size_t K = detail::unrolled_list_node_capacity(sizeof(T)), typename Alloc = MySTL::allocator<T>>
+    class unrolled_list {
+        static_assert(K >= 2, "unrolled_list needs at least two elements per node");
+
+        struct NodeBase {
+            NodeBase* prev;
+            NodeBase* next;
+        };
+
+        struct Node : NodeBase {
+            size_t count;
+            alignas(T) unsigned char buffer[K * sizeof(T)];
+
+            // 不初始化元素区，元素由 unrolled_list 按需构造
+            Node() noexcept : count(0) {}
+
+            T* data() noexcept { return reinterpret_cast<T*>(buffer); }
+            const T* data() const noexcept { return reinterpret_cast<const T*>(buffer); }
+        };
+
+        using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using node_alloc_traits = std::allocator_traits<node_allocator>;
+
+    public:
+        using value_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using difference_type = std::ptrdiff_t;
+        using allocator_type = Alloc;
+
+        static constexpr size_t node_capacity = K;
+
+        // ================== 迭代器实现 ==================
+        // 迭代器记录 (节点, 节点内下标)，end() 为 (哨兵, 0)
+        class const_iterator;
+
+        class iterator {
+        public:
+            friend class const_iterator;
+            friend class unrolled_list;
+
+            iterator(NodeBase* node = nullptr, size_t index = 0) : node_(node), index_(index) {}
+
+            reference operator*() const { return static_cast<Node*>(node_)->data()[index_]; }
+            pointer operator->() const { return &**this; }
+
+            iterator& operator++() {
+                if (++index_ == static_cast<Node*>(node_)->count) {
+                    node_ = node_->next;
+                    index_ = 0;
+                }
+                return *this;
+            }
+
+            iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+
+            iterator& operator--() {
+                if (index_ == 0) {
+                    node_ = node_->prev;
+                    index_ = static_cast<Node*>(node_)->count;
+                }
+                index_--;
+                return *this;
+            }
+
+            iterator operator--(int) { iterator tmp = *this; --(*this); return tmp; }
+
+            bool operator==(const iterator& other) const { return node_ == other.node_ && index_ == other.index_; }
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        private:
+            NodeBase* node_;
+            size_t index_;
+        };
+
+        class const_iterator {
+        public:
+            friend class unrolled_list;
+
+            const_iterator(const NodeBase* node = nullptr, size_t index = 0) : node_(node), index_(index) {}
+
+            const_iterator(const iterator& other) : node_(other.node_), index_(other.index_) {}
+
+            const_reference operator*() const { return static_cast<const Node*>(node_)->data()[index_]; }
+            const_pointer operator->() const { return &**this; }
+
+            const_iterator& operator++() {
+                if (++index_ == static_cast<const Node*>(node_)->count) {
+                    node_ = node_->next;
+                    index_ = 0;
+                }
+                return *this;
+            }
+
+            const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+
+            const_iterator& operator--() {
+                if (index_ == 0) {
+                    node_ = node_->prev;
+                    index_ = static_cast<const Node*>(node_)->count;
+                }
+                index_--;
+                return *this;
+            }
+
+            const_iterator operator--(int) { const_iterator tmp = *this; --(*this); return tmp; }
+
+            bool operator==(const const_iterator& other) const { return node_ == other.node_ && index_ == other.index_; }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+        private:
+            const NodeBase* node_;
+            size_t index_;
+        };
+
+        unrolled_list() noexcept : size_(0), alloc_() {
+            init_header();
+        }
+
+        explicit unrolled_list(const Alloc& alloc) noexcept : size_(0), alloc_(alloc) {
+            init_header();
+        }
+
+        ~unrolled_list() {
+            clear();
+        }
+
+        // ================== 五法则实现 ==================
+
+        unrolled_list(const unrolled_list& other)
+            : size_(0), alloc_(node_alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
+            init_header();
+            for (const_iterator it = other.begin(); it != other.end(); ++it) {
+                push_back(*it);
+            }
+        }
+
+        unrolled_list& operator=(const unrolled_list& other) {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            for (const_iterator it = other.begin(); it != other.end(); ++it) {
+                push_back(*it);
+            }
+            return *this;
+        }
+
+        // 哨兵在对象内部，移动只需修正首尾节点的指针
+        unrolled_list(unrolled_list&& other) noexcept : alloc_(std::move(other.alloc_)) {
+            steal(other);
+        }
+
+        unrolled_list& operator=(unrolled_list&& other) noexcept {
+            if (this != &other) {
+                clear();
+                alloc_ = std::move(other.alloc_);
+                steal(other);
+            }
+            return *this;
+        }
+
+        // ================== 迭代器访问 ==================
+        iterator begin() noexcept { return iterator(header_.next, 0); }
+        iterator end() noexcept { return iterator(&header_, 0); }
+        const_iterator begin() const noexcept { return const_iterator(header_.next, 0); }
+        const_iterator end() const noexcept { return const_iterator(&header_, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+        // 空链表上调用是未定义行为
+        reference front() { return static_cast<Node*>(header_.next)->data()[0]; }
+        const_reference front() const { return static_cast<const Node*>(header_.next)->data()[0]; }
+
+        reference back() {
+            Node* last = static_cast<Node*>(header_.prev);
+            return last->data()[last->count - 1];
+        }
+
+        const_reference back() const {
+            const Node* last = static_cast<const Node*>(header_.prev);
+            return last->data()[last->count - 1];
+        }
+
+        // ================== 插入 ==================
+        void push_back(const_reference value) { emplace_back(value); }
+        void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+        void push_front(const_reference value) { emplace(begin(), value); }
+        void push_front(value_type&& value) { emplace(begin(), std::move(value)); }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... args) {
+            Node* last = static_cast<Node*>(header_.prev);
+            bool fresh = last == &header_ || last->count == K;
+            if (fresh) {
+                last = create_node(&header_);
+            }
+            try {
+                new(last->data() + last->count) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                if (fresh) {
+                    unlink(last);
+                    destroy_node(last);
+                }
+                throw;
+            }
+            last->count++;
+            size_++;
+            return last->data()[last->count - 1];
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args&&... args) {
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        iterator insert(const_iterator pos, const_reference value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, value_type&& value) { return emplace(pos, std::move(value)); }
+
+        // 在 pos 之前构造新元素，返回指向它的迭代器
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            if (pos.node_ == &header_) {
+                emplace_back(std::forward<Args>(args)...);
+                Node* last = static_cast<Node*>(header_.prev);
+                return iterator(last, last->count - 1);
+            }
+            Node* node = static_cast<Node*>(const_cast<NodeBase*>(pos.node_));
+            size_t index = pos.index_;
+            // 先构造好新元素，之后的平移只涉及移动
+            value_type tmp(std::forward<Args>(args)...);
+            if (index == 0 && node->prev != &header_ && static_cast<Node*>(node->prev)->count < K) {
+                // 插在节点开头而前驱还有空位时直接追加到前驱末尾，不必平移
+                Node* prev = static_cast<Node*>(node->prev);
+                new(prev->data() + prev->count) T(std::move(tmp));
+                prev->count++;
+                size_++;
+                return iterator(prev, prev->count - 1);
+            }
+            if (node->count == K) {
+                Node* right = split(node);
+                if (index > node->count) {
+                    index -= node->count;
+                    node = right;
+                }
+            }
+            insert_in_node(node, index, std::move(tmp));
+            size_++;
+            return iterator(node, index);
+        }
+
+        // ================== 删除 ==================
+        // 删除 pos 指向的元素，返回下一个元素的迭代器
+        iterator erase(const_iterator pos) {
+            Node* node = static_cast<Node*>(const_cast<NodeBase*>(pos.node_));
+            size_t index = pos.index_;
+            T* data = node->data();
+            for (size_t i = index; i + 1 < node->count; i++) {
+                data[i] = std::move(data[i + 1]);
+            }
+            node->count--;
+            data[node->count].~T();
+            size_--;
+
+            if (node->count == 0) {
+                NodeBase* next = node->next;
+                unlink(node);
+                destroy_node(node);
+                return iterator(next, 0);
+            }
+            // 不足半满且能与后继合并时，把后继的元素搬进来并释放后继
+            Node* next = static_cast<Node*>(node->next);
+            if (node->count < K / 2 && next != &header_ && node->count + next->count <= K) {
+                merge_next(node);
+            }
+            if (index < node->count) {
+                return iterator(node, index);
+            }
+            return iterator(node->next, 0);
+        }
+
+        void pop_back() {
+            if (size_ > 0) {
+                erase(--end());
+            }
+        }
+
+        void pop_front() {
+            if (size_ > 0) {
+                erase(begin());
+            }
+        }
+
+        void clear() noexcept {
+            NodeBase* cur = header_.next;
+            while (cur != &header_) {
+                NodeBase* next = cur->next;
+                destroy_node(static_cast<Node*>(cur));
+                cur = next;
+            }
+            init_header();
+            size_ = 0;
+        }
+
+        void swap(unrolled_list& other) noexcept {
+            MySTL::swap(header_.prev, other.header_.prev);
+            MySTL::swap(header_.next, other.header_.next);
+            MySTL::swap(size_, other.size_);
+            MySTL::swap(alloc_, other.alloc_);
+            unrolled_list* both[2] = {this, &other};
+            for (unrolled_list* l : both) {
+                if (l->size_ == 0) {
+                    l->init_header();
+                }
+                else {
+                    l->header_.next->prev = &l->header_;
+                    l->header_.prev->next = &l->header_;
+                }
+            }
+        }
+
+    private:
+        NodeBase header_; // 首尾相连的哨兵，不含元素
+        size_t size_;
+        node_allocator alloc_;
+
+        void init_header() noexcept {
+            header_.prev = &header_;
+            header_.next = &header_;
+        }
+
+        // 接管 other 的全部节点，调用前 *this 必须为空
+        void steal(unrolled_list& other) noexcept {
+            if (other.empty()) {
+                init_header();
+                size_ = 0;
+                return;
+            }
+            header_.next = other.header_.next;
+            header_.prev = other.header_.prev;
+            header_.next->prev = &header_;
+            header_.prev->next = &header_;
+            size_ = other.size_;
+            other.init_header();
+            other.size_ = 0;
+        }
+
+        static void unlink(NodeBase* node) noexcept {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+        }
+
+        // 分配一个空节点并链接到 pos 之前
+        Node* create_node(NodeBase* pos) {
+            Node* node = node_alloc_traits::allocate(alloc_, 1);
+            node_alloc_traits::construct(alloc_, node);
+            node->prev = pos->prev;
+            node->next = pos;
+            pos->prev->next = node;
+            pos->prev = node;
+            return node;
+        }
+
+        // 析构节点中的元素并释放节点，调用者负责先解除链接
+        void destroy_node(Node* node) noexcept {
+            for (size_t i = 0; i < node->count; i++) {
+                node->data()[i].~T();
+            }
+            node_alloc_traits::destroy(alloc_, node);
+            node_alloc_traits::deallocate(alloc_, node, 1);
+        }
+
+        // 把已满的 node 的后一半搬到新建的后继节点中，返回后继
+        Node* split(Node* node) {
+            Node* right = create_node(node->next);
+            size_t keep = K / 2;
+            T* src = node->data();
+            try {
+                // 移动构造可能抛异常时改用拷贝，失败后原节点保持不变
+                for (size_t i = keep; i < node->count; i++) {
+                    new(right->data() + right->count) T(std::move_if_noexcept(src[i]));
+                    right->count++;
+                }
+            }
+            catch (...) {
+                unlink(right);
+                destroy_node(right);
+                throw;
+            }
+            for (size_t i = keep; i < node->count; i++) {
+                src[i].~T();
+            }
+            node->count = keep;
+            return right;
+        }
+
+        // 把后继节点的全部元素搬到 node 末尾并释放后继，调用者保证放得下
+        // 合并只是优化，搬运失败时回滚并保持两个节点原样，不向外抛异常
+        void merge_next(Node* node) noexcept {
+            Node* next = static_cast<Node*>(node->next);
+            size_t old_count = node->count;
+            try {
+                for (size_t i = 0; i < next->count; i++) {
+                    new(node->data() + node->count) T(std::move_if_noexcept(next->data()[i]));
+                    node->count++;
+                }
+            }
+            catch (...) {
+                while (node->count > old_count) {
+                    node->count--;
+                    node->data()[node->count].~T();
+                }
+                return;
+            }
+            unlink(next);
+            destroy_node(next);
+        }
+
+        // 节点未满，把 [index, count) 后移一位后放入 value
+        static void insert_in_node(Node* node, size_t index, value_type&& value) {
+            T* data = node->data();
+            if (index == node->count) {
+                new(data + node->count) T(std::move(value));
+                node->count++;
+                return;
+            }
+            new(data + node->count) T(std::move(data[node->count - 1]));
+            node->count++;
+            for (size_t i = node->count - 2; i > index; i--) {
+                data[i] = std::move(data[i - 1]);
+            }
+            data[index] = std::move(value);
+        }
+    };
+}
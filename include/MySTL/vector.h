@@ -5,16 +5,54 @@
 #include <utility> // 引入forward、move
 #include <cmath>  // 引入 max
 #include <stdexcept>
+#include <memory> // 引入allocator_traits
+#include <algorithm> // 引入min
+#include <cstring> // 引入memcpy、memmove
+#include <exception> // 引入exception_ptr
+#include <functional> // 引入function
+#include <future>
+#include <iterator> // 引入begin、end
+#include <type_traits>
 #include "algorithm.h"
+#include "allocator.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "type_traits.h"
 
 namespace MySTL {
 
-    template<typename T>
+    // 标签类型：要求新元素只做默认初始化（new T 而非 new T()）
+    // 对 int、double、POD 结构体等平凡类型意味着不写入任何内容，内存保持原样
+    struct default_init_t {
+        explicit default_init_t() = default;
+    };
+    constexpr default_init_t default_init{};
+
+    // 标签类型：选择借助线程池并行构造/拷贝/填充的重载
+    // 线程池需要提供 size()（工作线程数）和 enqueue<void>(std::function<void()>) 返回 std::future<void>，
+    // 即 thread_pool.h 中 ThreadPool 的接口
+    struct parallel_t {
+        explicit parallel_t() = default;
+    };
+    constexpr parallel_t parallel{};
+
+    // Alloc: 分配器，默认走全局堆。可替换为内存池（见 memory_pool.h 的 PoolAllocator）或 arena
+    // Growth: 增长策略，见 growth_policy.h。默认 8 个起步、2 倍增长
+    template<typename T, typename Alloc = MySTL::allocator<T>, typename Growth = MySTL::grow_double>
     // 按17标准需要实现5法则，按20标准要实现6法则
     class vector {
+        // 所有分配、构造、析构都经由 allocator_traits，未实现的可选成员会自动退化为默认行为
+        using alloc_traits = std::allocator_traits<Alloc>;
+        // 编译期选择搬运方式：可平凡重定位时整块 memcpy/memmove，否则逐个移动
+        using relocatable = detail::relocatable_t<T>;
+        // 元素可按字节搬运且分配器能原地调整大小（如 mremap）时，扩容不再经过 分配-拷贝-释放
+        using reallocatable = std::integral_constant<bool,
+                relocatable::value && MySTL::has_reallocate<Alloc>::value>;
+
     public:
         // 为迭代器提供类型定义，以便与STL算法一起使用
         using value_type = T;
+        using allocator_type = Alloc;
         using pointer = T*;
         using const_pointer = const T*;
         using reference = T&;
@@ -22,9 +60,12 @@ namespace MySTL {
         using difference_type = std::ptrdiff_t;  // 本质是long类型，保证其值能囊括本平台上的最远指针距离
 
         // ================== 迭代器实现 ==================
+        // 必须提前声明，否则下面的 friend 声明会引入一个命名空间作用域的同名类
+        class const_iterator;
+
         class iterator {
         public:
-            friend class const_iterator;  // 不需要提前声明，因为内部类是互相可见的。
+            friend class const_iterator;
             
             iterator(pointer ptr) : ptr_(ptr) {}
 
@@ -87,34 +128,91 @@ namespace MySTL {
         };
 
 
-        vector() noexcept: data_(nullptr), size_(0), capacity_(0) {}
+        vector() noexcept: data_(nullptr), capacity_(0), size_(0), alloc_() {}
 
-        vector(size_t n, const value_type& value = value_type())
+        // 使用给定的分配器实例（有状态分配器，比如持有内存池指针）
+        explicit vector(const Alloc& alloc) noexcept
+            : data_(nullptr), capacity_(0), size_(0), alloc_(alloc) {}
+
+        vector(size_t n, const value_type& value = value_type(), const Alloc& alloc = Alloc())
+            : data_(nullptr), capacity_(0), size_(0), alloc_(alloc)
         {
-            data_ = static_cast<pointer>(
-                    ::operator new(n * sizeof(value_type)));
+            data_ = allocate(n);
             for (size_t i = 0; i < n; i++) {
-                new(&data_[i]) value_type(value);
+                alloc_traits::construct(alloc_, &data_[i], value);
             }
             size_ = n;
             capacity_ = n;
         }
 
+        // vector<char> buf(n, MySTL::default_init); read(fd, buf.data(), n);
+        // 缓冲区马上会被整体覆盖时，省掉一次无意义的清零
+        vector(size_t n, default_init_t, const Alloc& alloc = Alloc())
+            : data_(nullptr), capacity_(0), size_(0), alloc_(alloc)
+        {
+            data_ = allocate(n);
+            capacity_ = n;
+            default_construct_to(n, std::is_trivially_default_constructible<value_type>());
+        }
+
+        // 并行版本：把 [0, n) 切成若干段，由线程池的工作线程和调用线程同时构造
+        // 新分配的大块内存尚未被访问过，各段由各自的线程首次写入，页面会分散到各线程所在的 NUMA 节点
+        // 注意不要在该线程池自己的任务中调用，否则可能因等待自身而死锁
+        template<typename Pool>
+        vector(parallel_t, Pool& pool, size_t n, const value_type& value, const Alloc& alloc = Alloc())
+            : data_(nullptr), capacity_(0), size_(0), alloc_(alloc)
+        {
+            data_ = allocate(n);
+            capacity_ = n;
+            try {
+                parallel_construct(pool, 0, n, [this, &value](pointer p, size_t) {
+                    alloc_traits::construct(alloc_, p, value);
+                });
+            }
+            catch (...) {
+                deallocate(data_, capacity_);
+                throw;
+            }
+        }
+
+        // 并行拷贝构造
+        template<typename Pool>
+        vector(parallel_t, Pool& pool, const vector& other)
+            : data_(nullptr), capacity_(0), size_(0),
+              alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
+            data_ = allocate(other.capacity_);
+            capacity_ = other.capacity_;
+            try {
+                parallel_construct(pool, 0, other.size_, [this, &other](pointer p, size_t i) {
+                    alloc_traits::construct(alloc_, p, other.data_[i]);
+                });
+            }
+            catch (...) {
+                deallocate(data_, capacity_);
+                throw;
+            }
+        }
+
         ~vector() {
             // 销毁所有在内存中构造的对象
             clear();
-            // 释放原始内存 使用全局命名空间的delete运算符函数
-            ::operator delete(data_);
+            // 把原始内存还给分配器
+            deallocate(data_, capacity_);
         }
 
         // ================== 五法则实现 ==================
 
         // 拷贝构造
-        vector(const vector& other) {
+        // 分配器按标准约定由 select_on_container_copy_construction 决定是否沿用
+        vector(const vector& other)
+            : data_(nullptr), capacity_(0), size_(0),
+              alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
             // 分配足够的内存以拷贝构造元素
-            data_ = static_cast<pointer> (::operator new(other.capacity_ * sizeof(value_type)));
+            data_ = allocate(other.capacity_);
             for (size_t i = 0;i < other.size_;i++) {
-                new(&data_[i]) value_type(other.data_[i]);
+                alloc_traits::construct(alloc_, &data_[i], other.data_[i]);
             }
             size_ = other.size_;
             capacity_ = other.capacity_;
@@ -127,19 +225,22 @@ namespace MySTL {
             }
 
             clear(); // 清理现有资源
-            ::operator delete(data_);
+            deallocate(data_, capacity_);
+            data_ = nullptr;
+            capacity_ = 0;
 
             // 拷贝
-            data_ = static_cast<pointer> (::operator new(other.capacity_ * sizeof(value_type)));
+            data_ = allocate(other.capacity_);
             for (size_t i = 0;i < other.size_;i++) {
-                new(&data_[i]) value_type(other.data_[i]);
+                alloc_traits::construct(alloc_, &data_[i], other.data_[i]);
             }
             size_ = other.size_;
             capacity_ = other.capacity_;
+            return *this;
         }
 
-        // 移动构造
-        vector(vector&& other) noexcept {
+        // 移动构造  分配器随内存一起被移动过来，这样释放时才能还给正确的来源
+        vector(vector&& other) noexcept : alloc_(std::move(other.alloc_)) {
             // 窃取资源
             size_ = other.size_;
             capacity_ = other.capacity_;
@@ -157,12 +258,13 @@ namespace MySTL {
                 return *this;
             }
             clear(); // 析构
-            ::operator delete(data_);
+            deallocate(data_, capacity_);
 
-            // 窃取资源
+            // 窃取资源  连同分配器一起，因为旧内存将来要还给它
             size_ = other.size_;
             capacity_ = other.capacity_;
             data_ = other.data_;
+            alloc_ = std::move(other.alloc_);
 
             // 原对象置空
             other.data_ = nullptr;
@@ -182,6 +284,12 @@ namespace MySTL {
         const_iterator cend() const noexcept { return const_iterator(data_ + size_); }
 
 
+        allocator_type get_allocator() const noexcept { return alloc_; }
+
+        // 指向连续存储的首元素，对齐程度由分配器决定（见 aligned_allocator）
+        pointer data() noexcept { return data_; }
+        const_pointer data() const noexcept { return data_; }
+
         size_t size() const noexcept { return size_; }
         // 返回已分配存储的容量
         size_t capacity() const noexcept { return capacity_; }
@@ -195,31 +303,15 @@ namespace MySTL {
             if (new_capacity <= capacity_) {
                 return;
             }
-            pointer new_data = static_cast<pointer> (::operator new(new_capacity * sizeof(value_type)));
-
-            for (size_t i = 0;i < size_;i++) {
-                // 使用 placement new 和 move 来移动构造对象，避免拷贝
-                new(&new_data[i]) value_type(std::move(data_[i]));
-            }
-
-            // 销毁旧内存中的对象
-            for (size_t i = 0;i < size_;i++) {
-                data_[i].~value_type();
-            }
-
-            // 释放内存
-            ::operator delete(data_);
-
-            data_ = new_data;
-            capacity_ = new_capacity;
+            grow_storage(new_capacity, reallocatable());
         }
 
         void push_back(const_reference value) {
             if (size_ == capacity_) {
                 // 重新分配
-                reserve(capacity_ == 0 ? 8 : capacity_ * 2);
+                reserve(recommend(size_ + 1));
             }
-            new(&data_[size_]) value_type(value);
+            alloc_traits::construct(alloc_, &data_[size_], value);
             size_++;
         }
 
@@ -227,10 +319,10 @@ namespace MySTL {
         void push_back(value_type&& value) {
             if (size_ == capacity_) {
                 // 相等时就必须扩容，否则会逻辑上越界访问（尽管由于placement new不会出现报错，但事实上超出了capacity）
-                reserve(capacity_ == 0 ? 8 : capacity_ * 2);
+                reserve(recommend(size_ + 1));
             }
-            // 使用 placement new 和 move 来构造对象
-            new(&data_[size_]) value_type(std::move(value));
+            // 使用 move 来构造对象
+            alloc_traits::construct(alloc_, &data_[size_], std::move(value));
             size_++;
         }
 
@@ -239,62 +331,72 @@ namespace MySTL {
         // ... 对左侧意味着包展开并应用&&，对右侧意味着包声明
         void emplace_back(Args&&... args) {  // 触发转发引用规则、引用折叠规则，从而使得左右值语义能够被完整转发
             if (size_ == capacity_) {
-                reserve(capacity_ == 0 ? 8 : capacity_ * 2);
+                reserve(recommend(size_ + 1));
             }
             // 使用完美转发将参数传递给T的构造参数，以使编译器能选择最适合的构造函数
             // forward的工作方式：检查模板参数。若是引用，则转回左值，若是非引用，转回右值。
             // 这里要注意区分模板参数被推导的值和实际的参数值
-            new(&data_[size_]) value_type(std::forward<Args>(args)...);  // 参数包展开
+            alloc_traits::construct(alloc_, &data_[size_], std::forward<Args>(args)...);  // 参数包展开
             size_++;
         }
 
         // 在pos位置擦除元素
         iterator erase(const_iterator pos) {
-            difference_type index = pos - cbegin();
-            // 将pos后的元素向前移动一个位置
-            for (size_t i = index;i < size_ - 1;i++) {
-                data_[i] = std::move(data_[i + 1]);
-            }
-            // 销毁多余的
-            pop_back();
-            return iterator(data_ + index);
+            return erase(pos, pos + 1);
         }
 
         // 擦除范围内的元素
         iterator erase(const_iterator first, const_iterator last) {
             difference_type index_first = first - cbegin();
             difference_type index_last = last - cbegin();
-            difference_type count = index_last - index_first;
-            if (count > 0) {
-                for (size_t i = index_last; i < size_;i++) {
-                    data_[i - count] = std::move(data_[i]);
-                }
-                // 销毁末尾count个剩余元素
-                for (size_t i = 0;i < count;i++) {
-                    pop_back();  // 此时会减小size_，无需额外动作
-                }
+            if (index_last > index_first) {
+                detail::erase_range(alloc_, data_, size_, index_first, index_last);
             }
             return iterator(data_ + index_first);
         }
 
+        // 删除所有满足 pred 的元素，返回删除的个数
+        // 单趟压缩：保留的元素依次前移填补空位，最后统一析构尾部，整体 O(n)
+        template<typename Pred>
+        size_t erase_if(Pred pred) {
+            size_t out = 0;
+            while (out < size_ && !pred(data_[out])) {
+                out++;
+            }
+            for (size_t i = out + 1; i < size_; i++) {
+                if (!pred(data_[i])) {
+                    data_[out++] = std::move(data_[i]);
+                }
+            }
+            size_t removed = size_ - out;
+            destroy_n(data_ + out, removed);
+            size_ = out;
+            return removed;
+        }
+
+        // 不保持顺序的 O(1) 删除：用最后一个元素覆盖 pos 再弹出末尾
+        // 返回的迭代器指向原来的末尾元素（现在位于 pos），删除的是最后一个时等于 end()
+        iterator unordered_erase(const_iterator pos) {
+            difference_type index = pos - cbegin();
+            if (static_cast<size_t>(index) != size_ - 1) {
+                data_[index] = std::move(data_[size_ - 1]);
+            }
+            pop_back();
+            return iterator(data_ + index);
+        }
+
         // 在pos位置插入元素 拷贝
         iterator insert(const_iterator pos, const_reference value) {
             difference_type index = pos - cbegin();
             if (size_ == capacity_) {
-                reserve(capacity_ == 0 ? 8 : capacity_ * 2);
-            }
-            if (index < size_) {
-                new(&data_[size_]) value_type(std::move(data_[size_ - 1]));
-                for (size_t i = size_ - 1;i > index;i--) {
-                    data_[i] = std::move(data_[i - 1]);
-                }
-                data_[index] = value;
+                // value 可能引用本数组中的元素，扩容会释放旧内存，先把它取到局部
+                value_type tmp(value);
+                reserve(recommend(size_ + 1));
+                detail::insert_one(alloc_, data_, size_, index, std::move(tmp));
             }
             else {
-                new(&data_[size_]) value_type(value);
+                detail::insert_one(alloc_, data_, size_, index, value);
             }
-
-            size_++;
             return iterator(data_ + index);
         }
 
@@ -302,34 +404,106 @@ namespace MySTL {
         iterator insert(const_iterator pos, T&& value) {
             difference_type index = pos - cbegin();
             if (size_ == capacity_) {
-                reserve(capacity_ == 0 ? 8 : capacity_ * 2);
+                // value 可能引用本数组中的元素，扩容会释放旧内存，先把它取到局部
+                value_type tmp(std::move(value));
+                reserve(recommend(size_ + 1));
+                detail::insert_one(alloc_, data_, size_, index, std::move(tmp));
+            }
+            else {
+                detail::insert_one(alloc_, data_, size_, index, std::move(value));
+            }
+            return iterator(data_ + index);
+        }
+
+        // ================== 批量操作 ==================
+        // 先算出最终大小，最多重新分配一次，尾部元素只搬动一次
+        // 迭代器要求至少是前向迭代器（需要先数一遍长度）
+
+        // 在pos位置插入 [first, last)
+        // enable_if 排除整数类型，否则 insert(pos, 3, 5) 会被当成迭代器版本
+        template<typename ForwardIt,
+                typename = typename std::enable_if<!std::is_integral<ForwardIt>::value>::type>
+        iterator insert(const_iterator pos, ForwardIt first, ForwardIt last) {
+            difference_type index = pos - cbegin();
+            insert_range(index, first, MySTL::distance(first, last));
+            return iterator(data_ + index);
+        }
+
+        // 在pos位置插入n个value
+        iterator insert(const_iterator pos, size_t n, const_reference value) {
+            difference_type index = pos - cbegin();
+            if (n > 0) {
+                // value 可能引用的是本容器中的元素，搬动尾部之前先拷贝一份
+                value_type tmp(value);
+                insert_range(index, fill_iterator(&tmp), n);
             }
+            return iterator(data_ + index);
+        }
 
-            if (index < size_) {
-                new(&data_[size_]) value_type(std::move(data_[size_ - 1]));
-                for (size_t i = size_ - 1;i > index;i--) {   // for循环放外面可能是比较好的实践
-                    data_[i] = std::move(data_[i - 1]);
+        // 在末尾追加一个区间  range 只需支持 begin()/end()（容器、数组均可）
+        template<typename Range>
+        void append_range(const Range& range) {
+            using std::begin;
+            using std::end;
+            insert(cend(), begin(range), end(range));
+        }
+
+        // 用 [first, last) 替换全部内容
+        template<typename ForwardIt,
+                typename = typename std::enable_if<!std::is_integral<ForwardIt>::value>::type>
+        void assign(ForwardIt first, ForwardIt last) {
+            size_t n = MySTL::distance(first, last);
+            if (n > capacity_) {
+                // 容量不够时直接换一块新内存，旧元素无需搬运
+                pointer new_data = allocate(n);
+                size_t i = 0;
+                try {
+                    for (; i < n; ++i, ++first) {
+                        alloc_traits::construct(alloc_, &new_data[i], *first);
+                    }
+                }
+                catch (...) {
+                    destroy_n(new_data, i);
+                    deallocate(new_data, n);
+                    throw;
                 }
-                data_[index] = std::move(value); // 唯一区别。这里使用移动赋值
+                clear();
+                deallocate(data_, capacity_);
+                data_ = new_data;
+                capacity_ = n;
+                size_ = n;
+                return;
             }
-            else {
-                new(&data_[size_]) value_type(std::move(value));
+            // 容量足够：已有部分赋值，多出的部分构造，剩下的析构
+            size_t i = 0;
+            for (; i < n && i < size_; ++i, ++first) {
+                data_[i] = *first;
+            }
+            for (; i < n; ++i, ++first) {
+                alloc_traits::construct(alloc_, &data_[i], *first);
+                size_++;
             }
+            while (size_ > n) {
+                pop_back();
+            }
+        }
 
-            size_++;
-            return iterator(data_ + index);
+        void assign(size_t n, const_reference value) {
+            value_type tmp(value);
+            clear();
+            insert_range(0, fill_iterator(&tmp), n);
         }
 
         void pop_back() {
             if (size_ > 0) {
                 size_--;
-                data_[size_].~value_type();
+                alloc_traits::destroy(alloc_, &data_[size_]);
             }
         }
 
         void clear() noexcept {
             for (size_t i = 0; i < size_; ++i) {
-                data_[i].~value_type();
+                alloc_traits::destroy(alloc_, &data_[i]);
             }
             size_ = 0;
         }
@@ -360,16 +534,62 @@ namespace MySTL {
             else if (new_size > size_) {
                 // 扩大size_，同时需保证容量
                 if (new_size > capacity_) {
-                    reserve(std::max(new_size, capacity_*2));  // 增长因子为2,推荐容量和必须容量选最大
+                    reserve(recommend(new_size));
                 }
                 // 默认构造新添加的元素
                 for (size_t i = size_; i < new_size; ++i) {
-                    new(&data_[i]) value_type();
+                    alloc_traits::construct(alloc_, &data_[i]);
                 }
             }
             size_ = new_size;
         }
 
+        // 并行版本的 resize，新增的元素分段并行值初始化
+        template<typename Pool>
+        void resize(parallel_t, Pool& pool, size_t new_size) {
+            if (new_size <= size_) {
+                resize(new_size);
+                return;
+            }
+            if (new_size > capacity_) {
+                reserve(recommend(new_size));
+            }
+            parallel_construct(pool, size_, new_size, [this](pointer p, size_t) {
+                alloc_traits::construct(alloc_, p);
+            });
+        }
+
+        // 并行填充：用 n 个 value 替换全部内容
+        template<typename Pool>
+        void assign(parallel_t, Pool& pool, size_t n, const_reference value) {
+            value_type tmp(value);
+            clear();
+            if (n > capacity_) {
+                // 旧元素已清空，直接换一块新内存，让新页面由工作线程首次写入
+                pointer new_data = allocate(n);
+                deallocate(data_, capacity_);
+                data_ = new_data;
+                capacity_ = n;
+            }
+            parallel_construct(pool, 0, n, [this, &tmp](pointer p, size_t) {
+                alloc_traits::construct(alloc_, p, tmp);
+            });
+        }
+
+        // 与 resize 相同，但新元素只做默认初始化而非值初始化
+        // 平凡可默认构造的 T（int、float、POD 结构体）不会被清零，只移动 size 标记，新元素的值是未定的，
+        // 适合随后会被整体覆盖的缓冲区（I/O 读入、SIMD 输出）
+        void resize_default_init(size_t new_size) {
+            if (new_size <= size_) {
+                resize(new_size);
+                return;
+            }
+            if (new_size > capacity_) {
+                reserve(recommend(new_size));
+            }
+            default_construct_to(new_size, std::is_trivially_default_constructible<value_type>());
+        }
+
         // 重载[]运算符以访问元素
         value_type& operator[] (size_t index) {
             return data_[index];
@@ -385,11 +605,274 @@ namespace MySTL {
             MySTL::swap(data_, other.data_);
             MySTL::swap(size_, other.size_);
             MySTL::swap(capacity_, other.capacity_);
+            MySTL::swap(alloc_, other.alloc_);
         }
 
     private:
         value_type* data_;
         size_t capacity_;
         size_t size_;
+        Alloc alloc_;
+
+        pointer allocate(size_t n) {
+            return n == 0 ? nullptr : alloc_traits::allocate(alloc_, n);
+        }
+
+        void deallocate(pointer p, size_t n) noexcept {
+            if (p != nullptr) {
+                alloc_traits::deallocate(alloc_, p, n);
+            }
+        }
+
+        // 把同一个值重复 n 次伪装成一个前向迭代器，让 insert(pos, n, value) 复用区间插入
+        class fill_iterator {
+        public:
+            explicit fill_iterator(const_pointer value) : value_(value) {}
+            const_reference operator*() const { return *value_; }
+            fill_iterator& operator++() { return *this; }
+
+        private:
+            const_pointer value_;
+        };
+
+        // 把 size_ 增长到 n，调用前需保证容量足够
+        // 绕过 alloc_traits::construct：它没有参数时做的是值初始化，会把平凡类型清零
+        void default_construct_to(size_t n, std::true_type) noexcept {
+            size_ = n;
+        }
+
+        void default_construct_to(size_t n, std::false_type) {
+            for (; size_ < n; size_++) {
+                ::new (static_cast<void*>(&data_[size_])) value_type;
+            }
+        }
+
+        // 元素少于这个数时切分和调度的开销超过收益，直接在调用线程中构造
+        static constexpr size_t parallel_threshold = 1 << 14;
+
+        // 在 [first, last) 上调用 construct(&data_[i], i)，成功后 size_ = last
+        // 调用前需保证 size_ == first 且容量足够
+        // 任何一段抛出异常时，已构造的其他段全部析构，size_ 保持不变，异常重新抛给调用方
+        template<typename Pool, typename Construct>
+        void parallel_construct(Pool& pool, size_t first, size_t last, Construct construct) {
+            size_t n = last - first;
+            size_t chunks = n < parallel_threshold ? 1 : pool.size() + 1; // 调用线程也承担一段
+            size_t chunk = (n + chunks - 1) / chunks;
+
+            // 每段自己负责回滚自己已经构造的部分
+            auto run = [this, &construct](size_t b, size_t e) {
+                size_t i = b;
+                try {
+                    for (; i < e; i++) {
+                        construct(&data_[i], i);
+                    }
+                }
+                catch (...) {
+                    destroy_n(data_ + b, i - b);
+                    throw;
+                }
+            };
+
+            // done[c] 记录第 c 段是否构造成功，失败时据此析构其他段
+            MySTL::vector<char> done(chunks, 0);
+            MySTL::vector<std::future<void>> futures;
+            futures.reserve(chunks);
+            size_t submitted = 1; // 第 0 段留给调用线程
+            try {
+                for (; submitted < chunks && first + submitted * chunk < last; submitted++) {
+                    size_t b = first + submitted * chunk;
+                    size_t e = std::min(b + chunk, last);
+                    futures.push_back(pool.template enqueue<void>(std::function<void()>([&run, b, e] {
+                        run(b, e);
+                    })));
+                }
+            }
+            catch (...) {
+                // 提交失败（如线程池已停止），剩下的段改由调用线程完成
+            }
+
+            std::exception_ptr error;
+            for (size_t c = 0; c < chunks; c++) {
+                if (c >= 1 && c < submitted) {
+                    continue; // 交给线程池的段稍后等待
+                }
+                size_t b = first + c * chunk;
+                if (b >= last) {
+                    break;
+                }
+                try {
+                    run(b, std::min(b + chunk, last));
+                    done[c] = 1;
+                }
+                catch (...) {
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            // 无论成败都必须等所有任务结束，它们引用了本栈帧中的 run
+            for (size_t c = 1; c < submitted; c++) {
+                try {
+                    futures[c - 1].get();
+                    done[c] = 1;
+                }
+                catch (...) {
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            if (error) {
+                for (size_t c = 0; c < chunks; c++) {
+                    size_t b = first + c * chunk;
+                    if (done[c] && b < last) {
+                        destroy_n(data_ + b, std::min(b + chunk, last) - b);
+                    }
+                }
+                std::rethrow_exception(error);
+            }
+            size_ = last;
+        }
+
+        void destroy_n(pointer p, size_t n) noexcept {
+            for (size_t i = 0;i < n;i++) {
+                alloc_traits::destroy(alloc_, &p[i]);
+            }
+        }
+
+        // 在 index 处插入从 first 开始的 n 个元素
+        template<typename It>
+        void insert_range(size_t index, It first, size_t n) {
+            if (n == 0) {
+                return;
+            }
+            if (size_ + n > capacity_) {
+                insert_range_grow(index, first, n, reallocatable());
+                return;
+            }
+            insert_range_in_place(index, first, n, relocatable());
+        }
+
+        // 原地调整缓冲区大小后，按容量足够的情况处理
+        template<typename It>
+        void insert_range_grow(size_t index, It first, size_t n, std::true_type) {
+            reserve(recommend(size_ + n));
+            insert_range_in_place(index, first, n, relocatable());
+        }
+
+        template<typename It>
+        void insert_range_grow(size_t index, It first, size_t n, std::false_type) {
+            // 新元素直接构造在新内存的最终位置，前后两段各搬一次
+            size_t new_capacity = recommend(size_ + n);
+            pointer new_data = allocate(new_capacity);
+            size_t i = 0;
+            try {
+                for (; i < n; ++i, ++first) {
+                    alloc_traits::construct(alloc_, &new_data[index + i], *first);
+                }
+            }
+            catch (...) {
+                // 旧内存还没动过，回滚新内存即可
+                destroy_n(new_data + index, i);
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            detail::relocate(alloc_, new_data, data_, index);
+            detail::relocate(alloc_, new_data + index + n, data_ + index, size_ - index);
+            deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+            size_ += n;
+        }
+
+        template<typename It>
+        void insert_range_in_place(size_t index, It first, size_t n, std::true_type) {
+            size_t tail = size_ - index;
+            if (tail > 0) {
+                std::memmove(static_cast<void*>(data_ + index + n), static_cast<const void*>(data_ + index),
+                        tail * sizeof(value_type));
+            }
+            size_t i = 0;
+            try {
+                for (; i < n; ++i, ++first) {
+                    alloc_traits::construct(alloc_, &data_[index + i], *first);
+                }
+            }
+            catch (...) {
+                destroy_n(data_ + index, i);
+                if (tail > 0) {
+                    std::memmove(static_cast<void*>(data_ + index), static_cast<const void*>(data_ + index + n),
+                            tail * sizeof(value_type));
+                }
+                throw;
+            }
+            size_ += n;
+        }
+
+        template<typename It>
+        void insert_range_in_place(size_t index, It first, size_t n, std::false_type) {
+            size_t tail = size_ - index;
+            size_t old_size = size_;
+            if (tail > n) {
+                // 尾部比插入段长：尾部最后 n 个移动构造到未初始化区，其余向后移动赋值
+                for (size_t i = old_size - n;i < old_size;i++) {
+                    alloc_traits::construct(alloc_, &data_[i + n], std::move(data_[i]));
+                    size_++;
+                }
+                for (size_t i = old_size - n;i > index;i--) {
+                    data_[i + n - 1] = std::move(data_[i - 1]);
+                }
+                for (size_t i = 0;i < n;++i, ++first) {
+                    data_[index + i] = *first;
+                }
+            }
+            else {
+                // 插入段比尾部长：前 tail 个新值赋值到原尾部位置，其余新值和整段尾部都落在未初始化区
+                It mid = first;
+                for (size_t i = 0;i < tail;i++) {
+                    ++mid;
+                }
+                for (size_t i = tail;i < n;++i, ++mid) {
+                    alloc_traits::construct(alloc_, &data_[index + i], *mid);
+                    size_++;
+                }
+                for (size_t i = index;i < old_size;i++) {
+                    alloc_traits::construct(alloc_, &data_[i + n], std::move(data_[i]));
+                    size_++;
+                }
+                for (size_t i = 0;i < tail;++i, ++first) {
+                    data_[index + i] = *first;
+                }
+            }
+        }
+
+        // 由增长策略给出至少能容纳 required 个元素的新容量
+        size_t recommend(size_t required) const {
+            return Growth::next_capacity(capacity_, required, sizeof(value_type));
+        }
+
+        // 把容量扩大到 new_capacity
+        void grow_storage(size_t new_capacity, std::true_type) {
+            if (data_ == nullptr) {
+                data_ = allocate(new_capacity);
+            }
+            else {
+                data_ = alloc_.reallocate(data_, capacity_, new_capacity);
+            }
+            capacity_ = new_capacity;
+        }
+
+        void grow_storage(size_t new_capacity, std::false_type) {
+            pointer new_data = allocate(new_capacity);
+
+            // 把旧内存中的对象搬到新内存，旧对象随之结束生命周期
+            detail::relocate(alloc_, new_data, data_, size_);
+
+            // 释放内存
+            deallocate(data_, capacity_);
+
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
     };
 }
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define MEMORY_POOL_H
 
 #include <vector>
+#include <cstddef> // 引入max_align_t
 #include <stdexcept>
 #include <iostream>
+#include "MySTL/allocator.h"
 
 using std::vector;
 using std::bad_alloc;
@@ -104,6 +106,17 @@ public:
 
     }
 
+    size_t chunkSize() const {
+        return chunkSize_;
+    }
+
+    // 判断 ptr 是否落在本内存池管理的范围内
+    // 供 PoolAllocator 区分"池内块"和"池耗尽后回退到全局堆的块"
+    bool owns(const void* ptr) const {
+        const unsigned char* p = static_cast<const unsigned char*>(ptr);
+        return p >= pool_ && p < pool_ + (numChunks_ * chunkSize_);
+    }
+
 private:
     size_t chunkSize_;
     size_t numChunks_;
@@ -135,4 +148,68 @@ private:
 
 };
 
+// 把 MemoryPool 适配成标准分配器接口，可直接作为 MySTL::vector / MySTL::list 的 Alloc 参数
+// 例如: MemoryPool pool(64 * sizeof(int), 1024);
+//       MySTL::vector<int, PoolAllocator<int>> v{PoolAllocator<int>(pool)};
+// 一次请求能放进一个 chunk 时从池中取，否则（或池已耗尽）回退到全局堆
+// 分配器只持有池的指针，拷贝/rebind 后仍指向同一个池，池的生命周期由使用者保证
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(MemoryPool& pool) noexcept : pool_(&pool) {}
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    // 池块从 new[] 返回的首地址（只保证 alignof(max_align_t) 对齐）起按 chunkSize 等距排列，
+    // 只有 T 不是超额对齐、且 chunkSize 是 alignof(T) 的整数倍时每个块才满足 T 的对齐，否则一律走全局堆
+    // 全局堆经由 MySTL::allocator，超额对齐的 T 会走对齐分配
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw bad_alloc(); // n * sizeof(T) 会溢出
+        }
+        if (fits_pool_alignment() && n <= pool_->chunkSize() / sizeof(T)) {
+            try {
+                return static_cast<T*>(pool_->allocate());
+            }
+            catch (const bad_alloc&) {
+                // 池耗尽，走下面的全局堆
+            }
+        }
+        return MySTL::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (pool_->owns(ptr)) {
+            pool_->deallocate(ptr);
+        }
+        else {
+            MySTL::allocator<T>().deallocate(ptr, n);
+        }
+    }
+
+    MemoryPool* pool() const noexcept {
+        return pool_;
+    }
+
+private:
+    MemoryPool* pool_;
+
+    bool fits_pool_alignment() const noexcept {
+        return alignof(T) <= alignof(std::max_align_t) && pool_->chunkSize() % alignof(T) == 0;
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept {
+    return a.pool() == b.pool();
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept {
+    return !(a == b);
+}
+
 #endif
\ No newline at end of file
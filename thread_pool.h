@@ -128,6 +128,11 @@ public:
         return result_future;
     }
 
+    // 工作线程数，供调用方决定任务切分的粒度
+    size_t size() const {
+        return workers.size();
+    }
+
 private:
     vector<thread> workers;
     queue<function<void()>> tasks;